@@ -29,8 +29,18 @@
 // ERROR_RETURN and its options------------------------------------------------------------------------------
 // ----------------------------------------------------------------------------------------------------------
 
+/// error paths are never the expected outcome, so branches into them are laid out as not taken.
+#define ERROR_UNLIKELY(cond) __builtin_expect(!!(cond), 0)
+
 /// this lets ERROR_RETURN log the error before returning.
-#ifndef ERROR_RETURN_LOG_DISABLE
+/// with ERROR_RETURN_COLD, reporting is instead a single out of line call to error_return_cold() which the project
+/// defines, so the error paths don't inline any logging into their callers. custom messages are dropped then.
+#if defined(ERROR_RETURN_COLD)
+    __attribute__((cold, noinline))
+    void error_return_cold(int error_code, const char *expr, const char *file, int line, const char *func);
+    #define ERROR_RETURN_LOG(error_code) error_return_cold((int)(error_code), #error_code, __FILE__, __LINE__, __func__)
+    #define ERROR_RETURN_LOG_FMT(error_code, fmt, ...) ERROR_RETURN_LOG(error_code)
+#elif !defined(ERROR_RETURN_LOG_DISABLE)
     #define ERROR_RETURN_LOG(error_code) LOG_ERROR_FMT("error: %d (%s)", error_code, #error_code)
     #define ERROR_RETURN_LOG_FMT(error_code, fmt, ...) \
         LOG_ERROR_FMT("error: %d (%s): " fmt, error_code, #error_code, ##__VA_ARGS__)
@@ -132,14 +142,14 @@
 #define EXPECT(func, T, ...) ({\
     T res;\
     int expect_error = (int)func(&res, ##__VA_ARGS__);\
-    if (expect_error != 0) {ERROR_RETURN(expect_error);}\
+    if (ERROR_UNLIKELY(expect_error != 0)) {ERROR_RETURN(expect_error);}\
     res;\
 })
 
 #define ASSERT_EXPECT(func, T, ...) ({\
     T res;\
     int expect_error = (int)func(&res, ##__VA_ARGS__);\
-    if (expect_error != 0) {ERROR_ASSERT(expect_error);}\
+    if (ERROR_UNLIKELY(expect_error != 0)) {ERROR_ASSERT(expect_error);}\
     res;\
 })
 
@@ -148,14 +158,14 @@
 #define EXPECT_S(func, self, T, ...) ({\
     T res;\
     int expect_error = (int)func(self, &res, ##__VA_ARGS__);\
-    if (expect_error != 0) {ERROR_RETURN(expect_error);}\
+    if (ERROR_UNLIKELY(expect_error != 0)) {ERROR_RETURN(expect_error);}\
     res;\
 })
 
 #define ASSERT_EXPECT_S(func, self, T, ...) ({\
     T res;\
     int expect_error = (int)func(self, &res, ##__VA_ARGS__);\
-    if (expect_error != 0) {ERROR_ASSERT(expect_error);}\
+    if (ERROR_UNLIKELY(expect_error != 0)) {ERROR_ASSERT(expect_error);}\
     res;\
 })
 
@@ -163,28 +173,28 @@
 #define EXPECT_OR_REDIR(err, func, T, ...) ({\
     T res;\
     int expect_error = (int)func(&res, ##__VA_ARGS__);\
-    if (expect_error != 0) {ERROR_RETURN(err);}\
+    if (ERROR_UNLIKELY(expect_error != 0)) {ERROR_RETURN(err);}\
     res;\
 })
 
 #define ASSERT_EXPECT_OR_REDIR(err, func, T, ...) ({\
     T res;\
     int expect_error = (int)func(&res, ##__VA_ARGS__);\
-    if (expect_error != 0) {ERROR_ASSERT(err);}\
+    if (ERROR_UNLIKELY(expect_error != 0)) {ERROR_ASSERT(err);}\
     res;\
 })
 
 #define EXPECT_S_OR_REDIR(err, func, self, T, ...) ({\
     T res;\
     int expect_error = (int)func(self, &res, ##__VA_ARGS__);\
-    if (expect_error != 0) {ERROR_RETURN(err);}\
+    if (ERROR_UNLIKELY(expect_error != 0)) {ERROR_RETURN(err);}\
     res;\
 })
 
 #define ASSERT_EXPECT_S_OR_REDIR(err, func, self, T, ...) ({\
     T res;\
     int expect_error = (int)func(self, &res, ##__VA_ARGS__);\
-    if (expect_error != 0) {ERROR_ASSERT(err);}\
+    if (ERROR_UNLIKELY(expect_error != 0)) {ERROR_ASSERT(err);}\
     res;\
 })
 
@@ -199,39 +209,39 @@
 /// takes an expression that evaluates to an error code such as the return of a function call and ERROR_RETURN its error code if it's not 0
 #define EXPECT_PASS(expr) do{\
     int expect_error = (int)(expr);\
-    if (expect_error != 0) ERROR_RETURN(expect_error);\
+    if (ERROR_UNLIKELY(expect_error != 0)) ERROR_RETURN(expect_error);\
 }while(0)
 
 #define ASSERT_EXPECT_PASS(expr) do{\
     int expect_error = (int)(expr);\
-    if (expect_error != 0) ERROR_ASSERT(expect_error);\
+    if (ERROR_UNLIKELY(expect_error != 0)) ERROR_ASSERT(expect_error);\
 }while(0)
 
 /// like EXPECT_PASS, but in case of error, it ERROR_RETURNs a specified error
 #define EXPECT_PASS_OR_REDIR(expr, output_error_code) do{\
-    if ((expr) != 0) ERROR_RETURN(output_error_code);\
+    if (ERROR_UNLIKELY((expr) != 0)) ERROR_RETURN(output_error_code);\
 }while(0)
 
 #define ASSERT_EXPECT_PASS_OR_REDIR(expr, output_error_code) do{\
-    if ((expr) != 0) ERROR_ASSERT(output_error_code);\
+    if (ERROR_UNLIKELY((expr) != 0)) ERROR_ASSERT(output_error_code);\
 }while(0)
 
 /// takes a boolean expression such as the return of a function call and ERROR_RETURNs it if it's false
 #define EXPECT_TRUE(expr) do{\
-    if (!(expr)) ERROR_RETURN(false);\
+    if (ERROR_UNLIKELY(!(expr))) ERROR_RETURN(false);\
 }while(0)
 
 #define ASSERT_EXPECT_TRUE(expr) do{\
-    if (!(expr)) ERROR_ASSERT(false);\
+    if (ERROR_UNLIKELY(!(expr))) ERROR_ASSERT(false);\
 }while(0)
 
 /// like EXPECT_TRUE, but in case of error, it ERROR_RETURNs a specified error
 #define EXPECT_TRUE_OR_REDIR(expr, output_error_code) do{\
-    if (!(expr)) ERROR_RETURN(output_error_code);\
+    if (ERROR_UNLIKELY(!(expr))) ERROR_RETURN(output_error_code);\
 }while(0)
 
 #define ASSERT_EXPECT_TRUE_OR_REDIR(expr, output_error_code) do{\
-    if (!(expr)) ERROR_ASSERT(output_error_code);\
+    if (ERROR_UNLIKELY(!(expr))) ERROR_ASSERT(output_error_code);\
 }while(0)
 
 #endif // COMMON_MACROS_H
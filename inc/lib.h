@@ -2,15 +2,85 @@
 #define LIB_H
 
 #include <stdbool.h>
+#include <stdatomic.h>
 #include "mini_inttypes.h"
+#include "ll_pool.h"
+#include "ll_api.h"
+
+LL_API_BEGIN
+
+// operations counted by ll_Stats
+typedef enum {
+    LL_OP_PUSH,
+    LL_OP_PUSH_FRONT,
+    LL_OP_POP,
+    LL_OP_POP_FRONT,
+    LL_OP_ITERATE,
+    LL_OP_INSERT,
+    LL_OP_SET,
+    LL_OP_GET,
+    LL_OP_REMOVE,
+    LL_OP_COUNT,
+}ll_Op;
+
+// orders two elements like qsort's comparator: negative, 0 or positive
+typedef int (*ll_CompareFn)(const void *a, const void *b);
+
+// per-list counters, only maintained when compiled with LL_STATS
+typedef struct {
+    u64 ops[LL_OP_COUNT];
+    // nodes walked by iterate_to, and how many of those walks started from the tail
+    u64 traversal_steps;
+    u64 tail_traversals;
+    u64 node_allocs;
+    u64 node_frees;
+    // payload bytes memcpy'd in or out of nodes
+    u64 bytes_copied;
+    u64 len_high_water;
+}ll_Stats;
 
 typedef struct {
     struct ll_LinkedListNode *head;
     struct ll_LinkedListNode *tail;
     u32 data_size;
-    u32 len;
+    // set by ll_reverse: the elements go from #tail to #head, each one following through prev
+    bool reversed;
+    size_t len;
+    // every node of the list is allocated from this pool
+    ll_NodePool pool;
+    // snapshot sharing the current nodes, the list copies them before its next mutation. NULL if not shared.
+    struct ll_Snapshot *snapshot;
+#ifdef LL_STATS
+    ll_Stats stats;
+#endif
 }ll_LinkedList;
 
+// where the memory of a list goes, see ll_memory_usage
+typedef struct {
+    // element data of the live nodes
+    size_t payload_bytes;
+    // links and padding of the live nodes
+    size_t link_bytes;
+    // the list header and the slab headers
+    size_t header_bytes;
+    // allocated node space holding no element: recycled nodes and the unused end of slabs
+    size_t slack_bytes;
+    // everything above
+    size_t total_bytes;
+}ll_MemoryUsage;
+
+// immutable view of a list, see ll_snapshot. its nodes can be walked from #head like the list's.
+typedef struct ll_Snapshot {
+    struct ll_LinkedListNode *head;
+    struct ll_LinkedListNode *tail;
+    u32 data_size;
+    size_t len;
+    // one per ll_snapshot that returned it, plus one while its list still shares the nodes
+    _Atomic u32 refs;
+    // pool of the nodes, handed over by the list when it stops sharing them
+    ll_NodePool pool;
+}ll_Snapshot;
+
 struct ll_LinkedListNode {
     struct ll_LinkedListNode *next;
     struct ll_LinkedListNode *prev;
@@ -41,20 +111,55 @@ typedef enum {
     LL_ERROR_INIT_FAILURE,
     LL_ERROR_MALLOC_FAILURE,
     LL_ERROR_INSUFFICIENT_SIZE,
+    LL_ERROR_IO_FAILURE,
+    LL_ERROR_INVALID_FORMAT,
+    LL_ERROR_CHECKSUM_MISMATCH,
+    LL_ERROR_UNSUPPORTED,
+    LL_ERROR_INVALID_LINK,
     LL_ERROR_INTERNAL,
 }ll_Error;
 
 ll_LinkedList* ll_new(u32 data_size);
+ll_LinkedList* ll_new_small(u32 data_size, u32 inline_count);
+ll_LinkedList* ll_new_with_allocator(u32 data_size, const ll_Allocator *alloc, void *alloc_ctx);
+ll_Error ll_allocator_bulk_free(const ll_Allocator *alloc, void *alloc_ctx);
 ll_Error ll_free(ll_LinkedList **self);
-bool ll_is_empty(const ll_LinkedList *self);
 ll_Error ll_push(ll_LinkedList *self, void *elem);
 ll_Error ll_push_front(ll_LinkedList *self, void *elem);
 ll_Error ll_pop(ll_LinkedList *self, void *out_elem);
 ll_Error ll_pop_front(ll_LinkedList *self, void *out_elem);
 ll_Error iterate_to(const ll_LinkedList *self, struct ll_LinkedListNode **out_node, int index);
 ll_Error ll_insert(ll_LinkedList *self, int index, void *elem);
+ll_Error ll_set(ll_LinkedList *self, int index, void *elem);
 ll_Error ll_get(const ll_LinkedList *self, void *out_elem, int index);
 ll_Error ll_remove(ll_LinkedList *self, void *out_elem, int index);
+// 64-bit variants for lists of more than INT_MAX elements. the int API above wraps them.
+ll_Error iterate_to64(const ll_LinkedList *self, struct ll_LinkedListNode **out_node, size_t index);
+ll_Error ll_insert64(ll_LinkedList *self, size_t index, void *elem);
+ll_Error ll_set64(ll_LinkedList *self, size_t index, void *elem);
+ll_Error ll_get64(const ll_LinkedList *self, void *out_elem, size_t index);
+ll_Error ll_remove64(ll_LinkedList *self, void *out_elem, size_t index);
+ll_Error ll_insert_many_at(ll_LinkedList *self, const int *indices, const void *elems, u32 k);
+ll_Error ll_remove_many_at(ll_LinkedList *self, const int *indices, void *out, u32 k);
+ll_Error ll_copy_range(const ll_LinkedList *self, size_t from, size_t count, void *dst);
+ll_Error ll_to_array(const ll_LinkedList *self, void *dst);
+ll_LinkedList* ll_from_array(u32 data_size, const void *src, size_t count);
+ll_LinkedList* ll_clone(const ll_LinkedList *self);
+ll_Error ll_merge(ll_LinkedList *dst, ll_LinkedList *a, ll_LinkedList *b, ll_CompareFn cmp);
+ll_Error ll_merge_k(ll_LinkedList *dst, ll_LinkedList *const *lists, u32 k, ll_CompareFn cmp);
+ll_Error ll_reverse(ll_LinkedList *self);
+ll_Error ll_rotate(ll_LinkedList *self, i64 k);
+ll_Error ll_save(const ll_LinkedList *self, int fd);
+ll_Error ll_load(int fd, ll_LinkedList **out_list);
+ll_Error ll_ingest_fd(ll_LinkedList *self, int fd, u32 max_records, u32 *out_records);
+ll_Error ll_drain_fd(ll_LinkedList *self, int fd, u32 max_records, u32 *out_records);
+ll_Snapshot* ll_snapshot(ll_LinkedList *self);
+ll_Error ll_snapshot_release(ll_Snapshot **self);
+ll_Error ll_snapshot_get(const ll_Snapshot *self, void *out_elem, size_t index);
+ll_Error ll_memory_usage(const ll_LinkedList *self, ll_MemoryUsage *out_usage);
+ll_Error ll_shrink(ll_LinkedList *self, size_t *out_reclaimed);
+ll_Error ll_stats_get(const ll_LinkedList *self, ll_Stats *out_stats);
+ll_Error ll_stats_reset(ll_LinkedList *self);
 
 
 ll_Error ll_buf_init(ll_BufferLinkedList *self, void *buffer, int data_size);
@@ -66,4 +171,24 @@ ll_Error ll_buf_insert(ll_BufferLinkedList *self, int index, void *elem);
 ll_Error ll_buf_get(const ll_BufferLinkedList *self, int index, void **out);
 ll_Error ll_buf_remove(ll_BufferLinkedList *self, int index);
 
+// fast paths, inlined into callers even across the lib archive
+
+static inline bool ll_is_empty(const ll_LinkedList *self) {
+    return (self != NULL 
+            && self->head == NULL && self->tail == NULL
+            && self->len == 0);
+}
+
+/// returns the number of elements, or 0 if #self is NULL.
+static inline size_t ll_len(const ll_LinkedList *self) {
+    return self != NULL ? self->len : 0;
+}
+
+/// returns the size of an element in bytes, or 0 if #self is NULL.
+static inline u32 ll_data_size(const ll_LinkedList *self) {
+    return self != NULL ? self->data_size : 0;
+}
+
+LL_API_END
+
 #endif // LIB_H
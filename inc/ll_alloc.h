@@ -0,0 +1,51 @@
+#ifndef LL_ALLOC_H
+#define LL_ALLOC_H
+
+#include <stddef.h>
+#include "mini_inttypes.h"
+#include "ll_api.h"
+
+LL_API_BEGIN
+
+// allocator for a list's header and node slabs. every callback receives the context given along with the
+// allocator.
+//  - alloc returns NULL on failure.
+//  - free may be NULL for arena-like allocators. lists then never release memory themselves, ll_free only
+//    drops the list, and the memory goes away with the arena.
+//  - bulk_free may be NULL. otherwise it releases everything allocated through the context at once, see
+//    ll_allocator_bulk_free.
+typedef struct {
+    void* (*alloc)(void *ctx, size_t size);
+    void (*free)(void *ctx, void *ptr, size_t size);
+    void (*bulk_free)(void *ctx);
+}ll_Allocator;
+
+// malloc/free, used when no allocator is given
+extern const ll_Allocator ll_default_allocator;
+
+
+// bump allocator over a chain of blocks. allocations can't be freed individually, only all at once with
+// ll_arena_reset or ll_arena_destroy.
+struct ll_ArenaBlock {
+    struct ll_ArenaBlock *next;
+    size_t size;
+    size_t used;
+    _Alignas(16) u8 data[];
+};
+
+typedef struct {
+    struct ll_ArenaBlock *blocks;
+    size_t block_size;
+}ll_Arena;
+
+// ll_Allocator over an ll_Arena, which is passed as the context
+extern const ll_Allocator ll_arena_allocator;
+
+void ll_arena_init(ll_Arena *self, size_t block_size);
+void* ll_arena_alloc(ll_Arena *self, size_t size);
+void ll_arena_reset(ll_Arena *self);
+void ll_arena_destroy(ll_Arena *self);
+
+LL_API_END
+
+#endif // LL_ALLOC_H
@@ -0,0 +1,9 @@
+#ifndef LL_API_H
+#define LL_API_H
+
+// the optimized profile compiles with -fvisibility=hidden so that only the public API is exported and everything
+// else can be inlined or dropped by LTO. public headers wrap their declarations in LL_API_BEGIN / LL_API_END.
+#define LL_API_BEGIN _Pragma("GCC visibility push(default)")
+#define LL_API_END _Pragma("GCC visibility pop")
+
+#endif // LL_API_H
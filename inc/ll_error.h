@@ -0,0 +1,30 @@
+#ifndef LL_ERROR_H
+#define LL_ERROR_H
+
+#include "mini_inttypes.h"
+#include "ll_api.h"
+
+LL_API_BEGIN
+
+// number of recent errors remembered per thread
+#define LL_ERROR_RING_SIZE 16
+
+// where an error was reported by ERROR_RETURN (or an EXPECT macro) when compiled with ERROR_RETURN_COLD
+typedef struct {
+    int code;
+    const char *expr;
+    const char *file;
+    int line;
+    const char *func;
+    // errors reported by this thread so far, including this one
+    u64 seq;
+}ll_ErrorContext;
+
+const ll_ErrorContext* ll_last_error_context(void);
+u32 ll_error_contexts(ll_ErrorContext *out, u32 max);
+void ll_error_clear(void);
+void ll_error_set_log_limit(u32 per_second);
+
+LL_API_END
+
+#endif // LL_ERROR_H
@@ -0,0 +1,47 @@
+#ifndef LL_INTRUSIVE_H
+#define LL_INTRUSIVE_H
+
+#include <stddef.h>
+#include <stdbool.h>
+#include "mini_inttypes.h"
+#include "lib.h"
+#include "ll_api.h"
+
+LL_API_BEGIN
+
+// returns the struct of type #type that embeds the ll_Link #ptr as its member #member.
+#define LL_CONTAINER_OF(ptr, type, member) ((type*)((char*)(ptr) - offsetof(type, member)))
+
+// link embedded in a user struct. a struct can be on several lists at once through several links.
+// a link that's on no list has NULL next and prev, so zero initialized links (or LL_LINK_INIT) are ready to use.
+typedef struct ll_Link {
+    struct ll_Link *next;
+    struct ll_Link *prev;
+}ll_Link;
+
+#define LL_LINK_INIT {NULL, NULL}
+
+// linkedlist of ll_Links. the library never allocates or copies for it, the links and their structs are owned
+// by the caller. the list is circular through #root, so every link on it has non NULL neighbours.
+typedef struct {
+    ll_Link root;
+    size_t len;
+}ll_IntrusiveList;
+
+ll_Error ll_intrusive_init(ll_IntrusiveList *self);
+bool ll_link_is_linked(const ll_Link *link);
+ll_Error ll_intrusive_push(ll_IntrusiveList *self, ll_Link *link);
+ll_Error ll_intrusive_push_front(ll_IntrusiveList *self, ll_Link *link);
+ll_Error ll_intrusive_pop(ll_IntrusiveList *self, ll_Link **out_link);
+ll_Error ll_intrusive_pop_front(ll_IntrusiveList *self, ll_Link **out_link);
+ll_Error ll_intrusive_link_before(ll_IntrusiveList *self, ll_Link *pos, ll_Link *link);
+ll_Error ll_intrusive_link_after(ll_IntrusiveList *self, ll_Link *pos, ll_Link *link);
+ll_Error ll_intrusive_unlink(ll_IntrusiveList *self, ll_Link *link);
+ll_Link* ll_intrusive_first(const ll_IntrusiveList *self);
+ll_Link* ll_intrusive_last(const ll_IntrusiveList *self);
+ll_Link* ll_intrusive_next(const ll_IntrusiveList *self, const ll_Link *link);
+ll_Link* ll_intrusive_prev(const ll_IntrusiveList *self, const ll_Link *link);
+
+LL_API_END
+
+#endif // LL_INTRUSIVE_H
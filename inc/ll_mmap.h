@@ -0,0 +1,39 @@
+#ifndef LL_MMAP_H
+#define LL_MMAP_H
+
+#include <stddef.h>
+#include "mini_inttypes.h"
+#include "lib.h"
+#include "ll_api.h"
+
+LL_API_BEGIN
+
+// persistent linkedlist stored in a memory mapped file. links are byte offsets from the start of the mapping
+// so the file can be remapped at any address, and reopening it needs no deserialization.
+typedef struct {
+    u8 *base;
+    size_t size;
+    int fd;
+    u32 data_size;
+}ll_MappedLinkedList;
+
+// node layout inside the file. offset 0 is the file header, so it doubles as the NULL link.
+struct ll_MappedLinkedListNode {
+    u64 next;
+    u64 prev;
+    u8 data[];
+};
+
+ll_Error ll_map_open(ll_MappedLinkedList *self, const char *path, u32 data_size);
+ll_Error ll_map_close(ll_MappedLinkedList *self);
+ll_Error ll_map_sync(const ll_MappedLinkedList *self);
+u64 ll_map_len(const ll_MappedLinkedList *self);
+ll_Error ll_map_push(ll_MappedLinkedList *self, const void *elem);
+ll_Error ll_map_push_front(ll_MappedLinkedList *self, const void *elem);
+ll_Error ll_map_pop(ll_MappedLinkedList *self, void *out_elem);
+ll_Error ll_map_pop_front(ll_MappedLinkedList *self, void *out_elem);
+ll_Error ll_map_get(const ll_MappedLinkedList *self, void *out_elem, u64 index);
+
+LL_API_END
+
+#endif // LL_MMAP_H
@@ -0,0 +1,59 @@
+#ifndef LL_NODE_ARENA_H
+#define LL_NODE_ARENA_H
+
+#include <stddef.h>
+#include "mini_inttypes.h"
+#include "lib.h"
+#include "ll_api.h"
+
+LL_API_BEGIN
+
+// index of no node. slot 0 of every arena is reserved for it so that zeroed list headers are empty lists.
+#define LL_ARENA_NIL 0
+
+// node store shared by many ll_ArenaLists of the same element size. nodes live in one growable array and link
+// to each other with 32-bit indices, so a node costs 8 bytes plus its payload and every list is released at
+// once with the arena. growing the array moves it: indices stay valid but pointers from ll_node_arena_data don't.
+typedef struct {
+    u8 *nodes;
+    u32 data_size;
+    u32 node_size;
+    u32 capacity;
+    // slots handed out so far, including the reserved one
+    u32 used;
+    // recycled nodes, linked through their next index
+    u32 free_head;
+}ll_NodeArena;
+
+struct ll_ArenaNode {
+    u32 next;
+    u32 prev;
+    u8 data[];
+};
+
+// header of a list whose nodes live in a ll_NodeArena. it's owned by the caller, typically embedded in a bigger
+// struct or array, and a zeroed header (LL_ARENA_LIST_INIT) is an empty list.
+typedef struct {
+    u32 head;
+    u32 tail;
+    u32 len;
+}ll_ArenaList;
+
+#define LL_ARENA_LIST_INIT {LL_ARENA_NIL, LL_ARENA_NIL, 0}
+
+ll_Error ll_node_arena_init(ll_NodeArena *self, u32 data_size, u32 initial_capacity);
+ll_Error ll_node_arena_destroy(ll_NodeArena *self);
+ll_Error ll_node_arena_reset(ll_NodeArena *self);
+void* ll_node_arena_data(const ll_NodeArena *self, u32 node);
+u32 ll_node_arena_next(const ll_NodeArena *self, u32 node);
+u32 ll_node_arena_prev(const ll_NodeArena *self, u32 node);
+
+ll_Error ll_arena_list_push(ll_NodeArena *arena, ll_ArenaList *self, const void *elem);
+ll_Error ll_arena_list_push_front(ll_NodeArena *arena, ll_ArenaList *self, const void *elem);
+ll_Error ll_arena_list_pop(ll_NodeArena *arena, ll_ArenaList *self, void *out_elem);
+ll_Error ll_arena_list_pop_front(ll_NodeArena *arena, ll_ArenaList *self, void *out_elem);
+ll_Error ll_arena_list_clear(ll_NodeArena *arena, ll_ArenaList *self);
+
+LL_API_END
+
+#endif // LL_NODE_ARENA_H
@@ -0,0 +1,45 @@
+#ifndef LL_POOL_H
+#define LL_POOL_H
+
+#include <stddef.h>
+#include <stdbool.h>
+#include "mini_inttypes.h"
+#include "ll_alloc.h"
+
+/// a slab of fixed-size nodes. nodes are handed out by bumping #used and are only given back to the system
+/// when the whole pool is destroyed.
+struct ll_PoolSlab {
+    struct ll_PoolSlab *next;
+    size_t capacity;
+    size_t used;
+    u8 nodes[];
+};
+
+/// fixed-size node allocator backing a list. freed nodes are kept on an intrusive free list (linked through
+/// their first word) and are reused before a new slab is allocated. slabs come from #alloc.
+typedef struct {
+    struct ll_PoolSlab *slabs;
+    void *free_nodes;
+    size_t node_size;
+    size_t next_capacity;
+    const ll_Allocator *alloc;
+    void *alloc_ctx;
+    // slab embedded in the pool's owner, see ll_pool_add_inline. it's never freed by the pool.
+    struct ll_PoolSlab *inline_slab;
+}ll_NodePool;
+
+void ll_pool_init(ll_NodePool *self, size_t node_size, const ll_Allocator *alloc, void *alloc_ctx);
+void ll_pool_destroy(ll_NodePool *self);
+void* ll_pool_alloc(ll_NodePool *self);
+void* ll_pool_alloc_run(ll_NodePool *self, size_t count);
+void ll_pool_free(ll_NodePool *self, void *node);
+size_t ll_pool_slab_bytes(const ll_NodePool *self, size_t capacity);
+void ll_pool_add_inline(ll_NodePool *self, void *memory, size_t capacity);
+struct ll_PoolSlab* ll_pool_detach_inline(ll_NodePool *self);
+bool ll_pool_is_inline(const ll_NodePool *self, const void *node);
+bool ll_pool_can_adopt(const ll_NodePool *self, const ll_NodePool *other);
+void ll_pool_adopt(ll_NodePool *self, ll_NodePool *other);
+size_t ll_pool_footprint(const ll_NodePool *self);
+size_t ll_pool_discard_pages(ll_NodePool *self);
+
+#endif // LL_POOL_H
@@ -0,0 +1,33 @@
+#ifndef LL_PROFILE_H
+#define LL_PROFILE_H
+
+#include <stddef.h>
+#include "mini_inttypes.h"
+#include "lib.h"
+
+/* hardware counter profiling of list variants, built and ran with `make profile`.
+ * every registered variant runs the same workloads and gets a row per workload in the report.
+ */
+
+#define LL_PROFILE_MAX_VARIANTS 16
+
+// a list implementation holding u64 elements, driven through these callbacks.
+// optional callbacks may be NULL, the workloads that need them are then skipped for the variant.
+typedef struct {
+    const char *name;
+    void* (*create)(void);
+    void (*destroy)(void *list);
+    ll_Error (*push)(void *list, u64 value);
+    ll_Error (*pop_front)(void *list, u64 *out_value);
+    // optional, sums every element from head to tail
+    u64 (*scan)(const void *list);
+    // optional, random access by index
+    ll_Error (*get)(const void *list, size_t index, u64 *out_value);
+    // optional, both are needed for the middle insert/remove workload
+    ll_Error (*insert)(void *list, size_t index, u64 value);
+    ll_Error (*remove)(void *list, size_t index, u64 *out_value);
+}ll_ProfileVariant;
+
+ll_Error ll_profile_register(const ll_ProfileVariant *variant);
+
+#endif // LL_PROFILE_H
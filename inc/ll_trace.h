@@ -0,0 +1,45 @@
+#ifndef LL_TRACE_H
+#define LL_TRACE_H
+
+#include <stddef.h>
+#include "mini_inttypes.h"
+#include "lib.h"
+#include "ll_api.h"
+
+LL_API_BEGIN
+
+/* latency instrumentation of the ll_* operations, only compiled in with LL_TRACE.
+ * latencies are measured in ticks: nanoseconds from clock_gettime, or TSC cycles when LL_TRACE_RDTSC is also
+ * defined on x86. histograms are process-wide and log2-bucketed: bucket i counts latencies in [2^i, 2^(i+1)),
+ * with 0 counted in bucket 0.
+ */
+
+#define LL_TRACE_BUCKETS 64
+
+typedef struct {
+    u64 count;
+    u64 total_ticks;
+    u64 max_ticks;
+    u64 buckets[LL_TRACE_BUCKETS];
+}ll_Histogram;
+
+// called around every traced operation. #index is -1 for operations without one, and #len is the list length
+// on entry and on exit respectively.
+typedef struct {
+    void (*enter)(ll_Op op, i64 index, size_t len, void *ctx);
+    void (*exit)(ll_Op op, i64 index, size_t len, ll_Error status, u64 ticks, void *ctx);
+}ll_TraceHooks;
+
+ll_Error ll_trace_set_hooks(const ll_TraceHooks *hooks, void *ctx);
+ll_Error ll_trace_histogram(ll_Op op, ll_Histogram *out_histogram);
+ll_Error ll_trace_percentile(ll_Op op, double percentile, u64 *out_ticks);
+ll_Error ll_trace_reset(void);
+
+#ifdef LL_TRACE
+u64 ll_trace_begin(ll_Op op, i64 index, size_t len);
+void ll_trace_end(ll_Op op, i64 index, size_t len, ll_Error status, u64 start);
+#endif
+
+LL_API_END
+
+#endif // LL_TRACE_H
@@ -0,0 +1,45 @@
+#ifndef LL_VAR_H
+#define LL_VAR_H
+
+#include <stddef.h>
+#include "mini_inttypes.h"
+#include "ll_pool.h"
+#include "lib.h"
+#include "ll_api.h"
+
+LL_API_BEGIN
+
+// payload capacities of the size classes are 8 << class bytes. larger payloads get their own allocation.
+#define LL_VAR_SIZE_CLASSES 9
+#define LL_VAR_LARGE_CLASS LL_VAR_SIZE_CLASSES
+
+// linkedlist of variable-length elements. each node stores its payload inline after its header, and nodes are
+// allocated from a pool per size class.
+typedef struct {
+    struct ll_VarLinkedListNode *head;
+    struct ll_VarLinkedListNode *tail;
+    size_t len;
+    size_t large_nodes;
+    ll_NodePool classes[LL_VAR_SIZE_CLASSES];
+}ll_VarLinkedList;
+
+struct ll_VarLinkedListNode {
+    struct ll_VarLinkedListNode *next;
+    struct ll_VarLinkedListNode *prev;
+    u32 len;
+    u32 size_class;
+    u8 data[];
+};
+
+ll_VarLinkedList* ll_var_new(void);
+ll_Error ll_var_free(ll_VarLinkedList **self);
+ll_Error ll_var_push_bytes(ll_VarLinkedList *self, const void *ptr, u32 len);
+ll_Error ll_var_push_front_bytes(ll_VarLinkedList *self, const void *ptr, u32 len);
+ll_Error ll_var_peek_bytes(const ll_VarLinkedList *self, const void **out_ptr, u32 *out_len);
+ll_Error ll_var_peek_front_bytes(const ll_VarLinkedList *self, const void **out_ptr, u32 *out_len);
+ll_Error ll_var_pop_bytes(ll_VarLinkedList *self, void *out, u32 out_capacity, u32 *out_len);
+ll_Error ll_var_pop_front_bytes(ll_VarLinkedList *self, void *out, u32 out_capacity, u32 *out_len);
+
+LL_API_END
+
+#endif // LL_VAR_H
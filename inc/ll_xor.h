@@ -0,0 +1,52 @@
+#ifndef LL_XOR_H
+#define LL_XOR_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "mini_inttypes.h"
+#include "ll_pool.h"
+#include "lib.h"
+#include "ll_api.h"
+
+LL_API_BEGIN
+
+// compact linkedlist for small elements. each node stores a single link word, the XOR of the addresses of its
+// neighbours, so a node costs 8 bytes plus its payload instead of 16. the list can still be walked from either
+// end since the address of one neighbour recovers the other.
+typedef struct {
+    struct ll_XorLinkedListNode *head;
+    struct ll_XorLinkedListNode *tail;
+    u32 data_size;
+    size_t len;
+    ll_NodePool pool;
+}ll_XorLinkedList;
+
+struct ll_XorLinkedListNode {
+    uintptr_t link;
+    u8 data[];
+};
+
+// position within a ll_XorLinkedList. it walks away from #prev, #node is NULL past the end.
+// it's invalidated by any operation that removes #prev or #node, or inserts between them.
+typedef struct {
+    const ll_XorLinkedList *list;
+    struct ll_XorLinkedListNode *prev;
+    struct ll_XorLinkedListNode *node;
+}ll_XorCursor;
+
+ll_XorLinkedList* ll_xor_new(u32 data_size);
+ll_Error ll_xor_free(ll_XorLinkedList **self);
+ll_Error ll_xor_push(ll_XorLinkedList *self, const void *elem);
+ll_Error ll_xor_push_front(ll_XorLinkedList *self, const void *elem);
+ll_Error ll_xor_pop(ll_XorLinkedList *self, void *out_elem);
+ll_Error ll_xor_pop_front(ll_XorLinkedList *self, void *out_elem);
+
+ll_Error ll_xor_cursor_front(const ll_XorLinkedList *self, ll_XorCursor *out_cursor);
+ll_Error ll_xor_cursor_back(const ll_XorLinkedList *self, ll_XorCursor *out_cursor);
+ll_Error ll_xor_cursor_next(ll_XorCursor *self);
+ll_Error ll_xor_cursor_reverse(ll_XorCursor *self);
+ll_Error ll_xor_cursor_get(const ll_XorCursor *self, void *out_elem);
+
+LL_API_END
+
+#endif // LL_XOR_H
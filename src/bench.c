@@ -0,0 +1,95 @@
+#ifdef LL_BENCH
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "lib.h"
+#include "ll_alloc.h"
+
+/* benchmark workloads, built and ran with `make bench`.
+ * each workload runs against lists from the default allocator and from an ll_Arena.
+ */
+
+#define BENCH_REQUESTS 200000
+#define BENCH_LISTS_PER_REQUEST 8
+#define BENCH_ELEMS_PER_LIST 32
+#define BENCH_CHURN_OPS 10000000
+
+static inline u64 now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (u64)ts.tv_sec * 1000000000u + ts.tv_nsec;
+}
+
+// keeps the compiler from discarding the popped values
+static volatile u64 bench_sink;
+
+/// per-request lists: a few short lists are built, partially drained and dropped for every request.
+/// returns the elapsed nanoseconds.
+static u64 bench_request_lists(ll_Arena *arena) {
+    u64 start = now_ns();
+    for (u32 r = 0; r < BENCH_REQUESTS; r++) {
+        ll_LinkedList *lists[BENCH_LISTS_PER_REQUEST];
+        for (u32 l = 0; l < BENCH_LISTS_PER_REQUEST; l++) {
+            lists[l] = arena != NULL ? ll_new_with_allocator(sizeof(u64), &ll_arena_allocator, arena)
+                                     : ll_new(sizeof(u64));
+            for (u64 i = 0; i < BENCH_ELEMS_PER_LIST; i++) ll_push(lists[l], &i);
+            u64 out;
+            for (u32 i = 0; i < BENCH_ELEMS_PER_LIST / 2; i++) ll_pop_front(lists[l], &out);
+            bench_sink += out;
+        }
+
+        if (arena != NULL) {
+            ll_arena_reset(arena);
+        } else {
+            for (u32 l = 0; l < BENCH_LISTS_PER_REQUEST; l++) ll_free(&lists[l]);
+        }
+    }
+    return now_ns() - start;
+}
+
+/// queue churn: a long lived queue with a steady push/pop_front rate.
+static u64 bench_queue_churn(ll_Arena *arena) {
+    ll_LinkedList *queue = arena != NULL ? ll_new_with_allocator(sizeof(u64), &ll_arena_allocator, arena)
+                                         : ll_new(sizeof(u64));
+    for (u64 i = 0; i < 1024; i++) ll_push(queue, &i);
+
+    u64 start = now_ns();
+    for (u64 i = 0; i < BENCH_CHURN_OPS; i++) {
+        u64 out;
+        ll_push(queue, &i);
+        ll_pop_front(queue, &out);
+        bench_sink += out;
+    }
+    u64 elapsed = now_ns() - start;
+
+    if (arena != NULL) ll_arena_reset(arena);
+    else ll_free(&queue);
+    return elapsed;
+}
+
+typedef struct {
+    const char *name;
+    u64 (*run)(ll_Arena *arena);
+    u64 ops;
+}BenchWorkload;
+
+int main(void) {
+    const BenchWorkload workloads[] = {
+        {"request lists", bench_request_lists, (u64)BENCH_REQUESTS * BENCH_LISTS_PER_REQUEST},
+        {"queue churn", bench_queue_churn, BENCH_CHURN_OPS},
+    };
+
+    ll_Arena arena;
+    ll_arena_init(&arena, 1 << 16);
+
+    printf("%-16s %14s %14s %8s\n", "workload", "default ns/op", "arena ns/op", "speedup");
+    for (u32 i = 0; i < sizeof(workloads) / sizeof(workloads[0]); i++) {
+        double default_ns = (double)workloads[i].run(NULL) / workloads[i].ops;
+        double arena_ns = (double)workloads[i].run(&arena) / workloads[i].ops;
+        printf("%-16s %14.2f %14.2f %7.2fx\n", workloads[i].name, default_ns, arena_ns, default_ns / arena_ns);
+    }
+
+    ll_arena_destroy(&arena);
+    return 0;
+}
+#endif // LL_BENCH
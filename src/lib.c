@@ -2,23 +2,252 @@
 #include <stdlib.h>
 #include <string.h>
 #include <stdbool.h>
+#include <stdatomic.h>
+#include <errno.h>
+#include <unistd.h>
+#include <poll.h>
+#include <sys/uio.h>
 #include "lib.h"
+#include "ll_trace.h"
 #define LOG_DEBUG_ENABLE
 /* #define ERROR_RETURN_LOG_DISABLE */
+// report errors out of line into the ll_error.h ring, keeping the hot paths free of logging code
+#define ERROR_RETURN_COLD
 #include "common_macros.h"
 
+// statistics are bookkeeping rather than list state, so they're also updated through const list pointers.
+// the lists themselves are always heap allocated, which makes the cast well defined.
+#ifdef LL_STATS
+#define STATS_ADD(self, field, n) (((ll_LinkedList*)(self))->stats.field += (n))
+#define STATS_OP(self, op) (((ll_LinkedList*)(self))->stats.ops[(op)]++)
+#define STATS_TRACK_LEN(self) do {\
+    if ((self)->len > (self)->stats.len_high_water) (self)->stats.len_high_water = (self)->len;\
+} while(0)
+#else
+#define STATS_ADD(self, field, n) ((void)0)
+#define STATS_OP(self, op) ((void)0)
+#define STATS_TRACK_LEN(self) ((void)0)
+#endif
 
-/// returns NULL on failure
-ll_LinkedList* ll_new(u32 data_size) {
-    ll_LinkedList *out = (ll_LinkedList*)malloc(sizeof(ll_LinkedList));
+// public operations are thin wrappers around their implementation so that they can be timed and traced as a
+// whole. internal calls go to the implementations directly so that an operation is only traced once.
+#ifdef LL_TRACE
+#define TRACED(op, self, index, call) do {\
+    u64 trace_start = ll_trace_begin((op), (index), (self) != NULL ? (self)->len : 0);\
+    ll_Error trace_status = (call);\
+    ll_trace_end((op), (index), (self) != NULL ? (self)->len : 0, trace_status, trace_start);\
+    return trace_status;\
+} while(0)
+#else
+#define TRACED(op, self, index, call) return (call)
+#endif
+
+/* ll_reverse only flips #reversed: the list's first element is then the tail node and every element follows
+ * through prev. the single element operations map their ends and indices, the ones walking many nodes go
+ * through first_node/next_node, or put the nodes back in order first with ensure_forward.
+ */
+
+static inline struct ll_LinkedListNode* first_node(const ll_LinkedList *self) {
+    return self->reversed ? self->tail : self->head;
+}
+
+static inline struct ll_LinkedListNode* next_node(const ll_LinkedList *self, const struct ll_LinkedListNode *node) {
+    return self->reversed ? node->prev : node->next;
+}
+
+/* copy-on-write snapshots. ll_snapshot points a snapshot at the list's nodes and marks the list as shared.
+ * the first mutation after that copies the whole chain into a new pool and hands the old pool, with the nodes
+ * the snapshot sees, over to the snapshot. nodes of a doubly linked list can't be copied one path at a time since
+ * every node is reachable from both of its neighbours, so the copy is done once per snapshot instead.
+ * the inline slab of a small list lives in the list's header, so it never goes to the snapshot: ll_snapshot
+ * moves the nodes out of it first, and it follows the list from pool to pool.
+ */
+
+static void snapshot_destroy(ll_Snapshot *snapshot, const ll_Allocator *alloc, void *alloc_ctx) {
+    if (alloc->free != NULL) alloc->free(alloc_ctx, snapshot, sizeof(ll_Snapshot));
+}
+
+static void snapshot_unref(ll_Snapshot *snapshot) {
+    if (atomic_fetch_sub_explicit(&snapshot->refs, 1, memory_order_acq_rel) != 1) return;
+    // the list hands its pool over before dropping its reference, so the pool is set by now
+    const ll_Allocator *alloc = snapshot->pool.alloc;
+    void *alloc_ctx = snapshot->pool.alloc_ctx;
+    ll_pool_destroy(&snapshot->pool);
+    snapshot_destroy(snapshot, alloc, alloc_ctx);
+}
+
+/// stops sharing the nodes with #self->snapshot. if the snapshot was released already it's simply dropped and
+/// the list keeps its pool. otherwise the snapshot takes the list's pool, the caller must give the list a new one.
+/// returns whether the pool was handed over.
+static bool hand_over_pool(ll_LinkedList *self) {
+    ll_Snapshot *snapshot = self->snapshot;
+    if (snapshot == NULL) return false;
+    self->snapshot = NULL;
+
+    // only ll_snapshot adds references, and it runs on the list's thread, so a count of 1 is final
+    if (atomic_load_explicit(&snapshot->refs, memory_order_acquire) == 1) {
+        snapshot_destroy(snapshot, self->pool.alloc, self->pool.alloc_ctx);
+        return false;
+    }
+    ll_pool_detach_inline(&self->pool);
+    snapshot->pool = self->pool;
+    snapshot_unref(snapshot);
+    return true;
+}
+
+/// initializes #out_pool as an empty pool with the list's node size and allocator.
+static inline void pool_like(const ll_LinkedList *self, ll_NodePool *out_pool) {
+    ll_pool_init(out_pool, self->pool.node_size, self->pool.alloc, self->pool.alloc_ctx);
+}
+
+/// moves the inline slab of #from, if any, to #to where it's empty.
+static inline void move_inline(ll_NodePool *from, ll_NodePool *to) {
+    struct ll_PoolSlab *slab = ll_pool_detach_inline(from);
+    if (slab != NULL) ll_pool_add_inline(to, slab, slab->capacity);
+}
+
+/// copies the nodes of the list, in order, into a single run of #pool, a pool set up with pool_like.
+/// the copies read from head to tail even if the list is reversed. nothing is allocated if the list is empty.
+static ll_Error copy_nodes(const ll_LinkedList *self, ll_NodePool *pool, struct ll_LinkedListNode **out_head,
+                           struct ll_LinkedListNode **out_tail) {
+    struct ll_LinkedListNode *head = NULL;
+    struct ll_LinkedListNode *tail = NULL;
+    if (self->len > 0) {
+        u8 *run = ll_pool_alloc_run(pool, self->len);
+        if (run == NULL) ERROR_RETURN(LL_ERROR_MALLOC_FAILURE);
+        STATS_ADD(self, node_allocs, self->len);
+        STATS_ADD(self, bytes_copied, (u64)self->len * self->data_size);
+
+        struct ll_LinkedListNode *node = first_node(self);
+        for (size_t i = 0; i < self->len; i++, node = next_node(self, node)) {
+            struct ll_LinkedListNode *copy = (struct ll_LinkedListNode*)(run + i * pool->node_size);
+            memcpy(copy->data, node->data, self->data_size);
+            copy->prev = tail;
+            copy->next = NULL;
+            if (tail == NULL) head = copy;
+            else tail->next = copy;
+            tail = copy;
+        }
+    }
+    *out_head = head;
+    *out_tail = tail;
+    return LL_OK;
+}
+
+/// gives the list private copies of its nodes, in a single run of a new pool.
+static ll_Error unshare(ll_LinkedList *self) {
+    if (atomic_load_explicit(&self->snapshot->refs, memory_order_acquire) == 1) {
+        hand_over_pool(self);
+        return LL_OK;
+    }
+
+    // the list's nodes are never inline while shared, so the inline slab can take the copy
+    ll_NodePool pool;
+    struct ll_LinkedListNode *head, *tail;
+    pool_like(self, &pool);
+    move_inline(&self->pool, &pool);
+    ll_Error status = copy_nodes(self, &pool, &head, &tail);
+    if (status != LL_OK) {
+        move_inline(&pool, &self->pool);
+        ll_pool_destroy(&pool);
+        return status;
+    }
+    // readers may have released the snapshot since the check above, the old pool is then the list's to free.
+    // its inline slab was already moved to the new pool.
+    if (!hand_over_pool(self)) ll_pool_destroy(&self->pool);
+    self->pool = pool;
+    self->head = head;
+    self->tail = tail;
+    self->reversed = false;
+    return LL_OK;
+}
+
+/// called by every mutation before it touches a node.
+static inline ll_Error ensure_unshared(ll_LinkedList *self) {
+    if (ERROR_UNLIKELY(self->snapshot != NULL)) return unshare(self);
+    return LL_OK;
+}
+
+/// reverses the links of every node so that the list reads from head to tail again.
+static ll_Error restore_order(ll_LinkedList *self) {
+    // copying shared nodes already puts them in order
+    EXPECT_PASS(ensure_unshared(self));
+    if (!self->reversed) return LL_OK;
+    struct ll_LinkedListNode *node = self->head;
+    while (node != NULL) {
+        struct ll_LinkedListNode *next = node->next;
+        node->next = node->prev;
+        node->prev = next;
+        node = next;
+    }
+    struct ll_LinkedListNode *head = self->head;
+    self->head = self->tail;
+    self->tail = head;
+    self->reversed = false;
+    return LL_OK;
+}
+
+/// called by the mutations that walk the nodes from the head, in O(len) once after a ll_reverse.
+static inline ll_Error ensure_forward(ll_LinkedList *self) {
+    if (ERROR_UNLIKELY(self->reversed)) return restore_order(self);
+    return LL_OK;
+}
+
+
+/// allocates the header of a list, followed by an inline slab of #inline_count nodes if it's not 0.
+static ll_LinkedList* new_list(u32 data_size, u32 inline_count, const ll_Allocator *alloc, void *alloc_ctx) {
+    if (alloc == NULL || alloc->alloc == NULL) return NULL;
+
+    ll_NodePool pool;
+    ll_pool_init(&pool, sizeof(struct ll_LinkedListNode) + data_size, alloc, alloc_ctx);
+    size_t size = sizeof(ll_LinkedList) + (inline_count > 0 ? ll_pool_slab_bytes(&pool, inline_count) : 0);
+    ll_LinkedList *out = (ll_LinkedList*)alloc->alloc(alloc_ctx, size);
     if (out == NULL) return NULL;
     out->head = NULL;
     out->tail = NULL;
     out->data_size = data_size;
+    out->reversed = false;
     out->len = 0;
+    out->pool = pool;
+    if (inline_count > 0) ll_pool_add_inline(&out->pool, out + 1, inline_count);
+    out->snapshot = NULL;
+#ifdef LL_STATS
+    memset(&out->stats, 0, sizeof(out->stats));
+#endif
     return out;
 }
 
+/// size of the allocation holding the list's header.
+static inline size_t header_size(const ll_LinkedList *self) {
+    const struct ll_PoolSlab *slab = self->pool.inline_slab;
+    return sizeof(ll_LinkedList) + (slab != NULL ? ll_pool_slab_bytes(&self->pool, slab->capacity) : 0);
+}
+
+
+/// returns NULL on failure
+ll_LinkedList* ll_new(u32 data_size) {
+    return new_list(data_size, 0, &ll_default_allocator, NULL);
+}
+
+
+/// creates a list whose first #inline_count nodes live in the same allocation as its header. nodes are only
+/// allocated once more than #inline_count elements are held at the same time, so a short-lived small list costs
+/// a single allocation. ll_snapshot copies the nodes out of the inline storage, in O(len), before sharing them.
+/// returns NULL on failure
+ll_LinkedList* ll_new_small(u32 data_size, u32 inline_count) {
+    return new_list(data_size, inline_count, &ll_default_allocator, NULL);
+}
+
+
+/// creates a list whose header and nodes are all allocated through #alloc.
+/// with an allocator that has no free callback (like ll_arena_allocator) the list doesn't need to be freed,
+/// its memory is reclaimed with the allocator's.
+/// @param alloc_ctx passed as is to every callback of #alloc.
+/// returns NULL on failure
+ll_LinkedList* ll_new_with_allocator(u32 data_size, const ll_Allocator *alloc, void *alloc_ctx) {
+    return new_list(data_size, 0, alloc, alloc_ctx);
+}
+
 
 /// deallocates the linkedlist and all of the nodes in it
 /// also sets the pointer to NULL to detect double free
@@ -27,14 +256,14 @@ ll_LinkedList* ll_new(u32 data_size) {
 ll_Error ll_free(ll_LinkedList **self) {
     if (*self == NULL) return LL_ERROR_NULL_LINKED_LIST_POINTER;
 
-    struct ll_LinkedListNode *node = (*self)->head;
-    while (node) {
-        struct ll_LinkedListNode *next = node->next;
-        free(node);
-        node = next;
-    }
+    // nodes live in the pool's slabs, so they are released without walking the list.
+    // nodes still shared with a snapshot are handed over to it instead.
+    const ll_Allocator *alloc = (*self)->pool.alloc;
+    void *alloc_ctx = (*self)->pool.alloc_ctx;
+    size_t size = header_size(*self);
+    if (!hand_over_pool(*self)) ll_pool_destroy(&(*self)->pool);
 
-    free(*self);
+    if (alloc->free != NULL) alloc->free(alloc_ctx, *self, size);
     // set to NULL to prevent this now invalidated pointer from being used
     *self = NULL;
 
@@ -42,17 +271,40 @@ ll_Error ll_free(ll_LinkedList **self) {
 }
 
 
-inline bool ll_is_empty(const ll_LinkedList *self) {
-    return (self != NULL 
-            && self->head == NULL && self->tail == NULL
-            && self->len == 0);
+static inline struct ll_LinkedListNode* node_alloc(ll_LinkedList *self) {
+    struct ll_LinkedListNode *node = ll_pool_alloc(&self->pool);
+    if (node != NULL) STATS_ADD(self, node_allocs, 1);
+    return node;
+}
+
+static inline void node_free(ll_LinkedList *self, struct ll_LinkedListNode *node) {
+    STATS_ADD(self, node_frees, 1);
+    ll_pool_free(&self->pool, node);
+}
+
+/// links the #count nodes of #run (from ll_pool_alloc_run) in order and appends them to the tail.
+static void link_run(ll_LinkedList *self, u8 *run, size_t count) {
+    const size_t stride = self->pool.node_size;
+    struct ll_LinkedListNode *prev = self->tail;
+    for (size_t i = 0; i < count; i++) {
+        struct ll_LinkedListNode *node = (struct ll_LinkedListNode*)(run + i * stride);
+        node->prev = prev;
+        if (prev == NULL) self->head = node;
+        else prev->next = node;
+        prev = node;
+    }
+    prev->next = NULL;
+    self->tail = prev;
+    self->len += count;
+    STATS_ADD(self, node_allocs, count);
+    STATS_TRACK_LEN(self);
 }
 
+
 // checks that the head and the tail are always at the edges of the linked list if they are initialized
 // except when there is only one element -- then the head and tail must point to the same spot.
 static inline ll_Error has_valid_head_tail_state(const ll_LinkedList *self, bool *res) {
     if (self == NULL) return LL_ERROR_NULL_LINKED_LIST_POINTER;
-    if (self->len < 0) return LL_ERROR_INTERNAL;
 
     bool out = true;
     // if there's only one node, ensure both #self->head and #self->tail point to it
@@ -66,13 +318,18 @@ static inline ll_Error has_valid_head_tail_state(const ll_LinkedList *self, bool
     return LL_OK;
 }
 
-/// checks that the given index is within the valid range for [0..self->len].
-static inline ll_Error is_index_within_get_bounds(const ll_LinkedList *self, bool *res, int index) {
+/// the int index API wraps the size_t one. negative indices map to SIZE_MAX, which is always out of bounds.
+static inline size_t index64(int index) {
+    return index < 0 ? SIZE_MAX : (size_t)index;
+}
+
+/// checks that the given index is within the valid range for [0..self->len).
+/// the comparison is done on unsigned sizes so that it holds for any length.
+static inline ll_Error is_index_within_get_bounds(const ll_LinkedList *self, bool *res, size_t index) {
     if (self == NULL) return LL_ERROR_NULL_LINKED_LIST_POINTER;
-    if (self->len < 0) return LL_ERROR_INTERNAL;
 
     bool out = true;
-    if (index < 0 || index >= (int)self->len) out = false;
+    if (index >= self->len) out = false;
     
     *res = out;
     return LL_OK;
@@ -80,17 +337,22 @@ static inline ll_Error is_index_within_get_bounds(const ll_LinkedList *self, boo
 
 /// checks that the given index is within the valid insertion range for [0..=self->len]
 /// if the index is self->len, this indicates a push to tail.
-static inline ll_Error is_index_within_insert_bounds(const ll_LinkedList *self, bool *res, int index) {
+static inline ll_Error is_index_within_insert_bounds(const ll_LinkedList *self, bool *res, size_t index) {
     if (self == NULL) return LL_ERROR_NULL_LINKED_LIST_POINTER;
-    if (self->len < 0) return LL_ERROR_INTERNAL;
 
     bool out = true;
-    if (index < 0 || index > (int)self->len) out = false;
+    if (index > self->len) out = false;
 
     *res = out;
     return LL_OK;
 }
 
+// the physical ends of the list, wrapped by push_impl and the others which swap them for a reversed list
+static ll_Error push_tail(ll_LinkedList *self, void *elem);
+static ll_Error push_head(ll_LinkedList *self, void *elem);
+static ll_Error pop_tail(ll_LinkedList *self, void *out_elem);
+static ll_Error pop_head(ll_LinkedList *self, void *out_elem);
+
 /// pushes an element node to the tail of the linked list.
 /// if it's the first item, the head and tail point to it.
 /// @returns LL_OK
@@ -98,15 +360,15 @@ static inline ll_Error is_index_within_insert_bounds(const ll_LinkedList *self,
 ///     || LL_ERROR_NULL_ELEMENT_POINTER
 ///     || LL_ERROR_MALLOC_FAILURE
 ///     || LL_ERROR_INTERNAL
-ll_Error ll_push(ll_LinkedList *self, void *elem) {
+static ll_Error push_tail(ll_LinkedList *self, void *elem) {
     if (self == NULL) return LL_ERROR_NULL_LINKED_LIST_POINTER;
     if (elem == NULL) return LL_ERROR_NULL_ELEMENT_POINTER;
     if (!EXPECT_S(has_valid_head_tail_state, self, bool)) ERROR_RETURN(LL_ERROR_INTERNAL);
+    EXPECT_PASS(ensure_unshared(self));
 
-    if (self->len < 0) ERROR_RETURN(LL_ERROR_INTERNAL);
     if (ll_is_empty(self)) {
         if (self->head != NULL) ERROR_RETURN(LL_ERROR_INTERNAL);
-        self->head = malloc(sizeof(struct ll_LinkedListNode));
+        self->head = node_alloc(self);
         if (self->head == NULL) ERROR_RETURN(LL_ERROR_MALLOC_FAILURE);
 
         self->head->prev = NULL;
@@ -116,7 +378,7 @@ ll_Error ll_push(ll_LinkedList *self, void *elem) {
     } else {
         if (self->head == NULL || self->tail == NULL) ERROR_RETURN(LL_ERROR_INTERNAL);
 
-        self->tail->next = malloc(sizeof(struct ll_LinkedListNode));
+        self->tail->next = node_alloc(self);
         if (self->tail->next == NULL) ERROR_RETURN(LL_ERROR_MALLOC_FAILURE);
         self->tail->next->prev = self->tail;
         self->tail->next->next = NULL;
@@ -127,25 +389,43 @@ ll_Error ll_push(ll_LinkedList *self, void *elem) {
     }
 
     self->len++;
+    STATS_ADD(self, bytes_copied, self->data_size);
+    STATS_TRACK_LEN(self);
     return LL_OK;
 }
 
+static inline ll_Error push_impl(ll_LinkedList *self, void *elem) {
+    if (self == NULL) return LL_ERROR_NULL_LINKED_LIST_POINTER;
+    if (elem == NULL) return LL_ERROR_NULL_ELEMENT_POINTER;
+    // unsharing copies the nodes in order and clears #reversed
+    EXPECT_PASS(ensure_unshared(self));
+    // counted here rather than at the physical end so a reversed list reports the call that was made
+    STATS_OP(self, LL_OP_PUSH);
+    if (self->reversed) return push_head(self, elem);
+    return push_tail(self, elem);
+}
+
+ll_Error ll_push(ll_LinkedList *self, void *elem) {
+    TRACED(LL_OP_PUSH, self, -1, push_impl(self, elem));
+}
+
 
 /// @returns LL_OK
 ///     || LL_ERROR_NULL_LINKED_LIST_POINTER
 ///     || LL_ERROR_NULL_ELEMENT_POINTER
 ///     || LL_ERROR_MALLOC_FAILURE
 ///     || LL_ERROR_INTERNAL
-ll_Error ll_push_front(ll_LinkedList *self, void *elem) {
+static ll_Error push_head(ll_LinkedList *self, void *elem) {
     if (self == NULL) return LL_ERROR_NULL_LINKED_LIST_POINTER;
     if (elem == NULL) return LL_ERROR_NULL_ELEMENT_POINTER;
+    EXPECT_PASS(ensure_unshared(self));
 
     if (ll_is_empty(self)) {
-        EXPECT_PASS(ll_push(self, elem));
+        EXPECT_PASS(push_tail(self, elem));
     } else {
         if (!EXPECT_S(has_valid_head_tail_state, self, bool)) ERROR_RETURN(LL_ERROR_INTERNAL);
 
-        self->head->prev = malloc(sizeof(struct ll_LinkedListNode));
+        self->head->prev = node_alloc(self);
         if (self->head->prev == NULL) ERROR_RETURN(LL_ERROR_MALLOC_FAILURE);
         self->head->prev->prev = NULL;
         self->head->prev->next = self->head;
@@ -153,28 +433,46 @@ ll_Error ll_push_front(ll_LinkedList *self, void *elem) {
         
         self->head = self->head->prev;
     
-        if (self->len < 0) ERROR_RETURN(LL_ERROR_INTERNAL);
         self->len++;
+        STATS_ADD(self, bytes_copied, self->data_size);
+        STATS_TRACK_LEN(self);
     }
 
     return LL_OK;
 }
 
+static inline ll_Error push_front_impl(ll_LinkedList *self, void *elem) {
+    if (self == NULL) return LL_ERROR_NULL_LINKED_LIST_POINTER;
+    if (elem == NULL) return LL_ERROR_NULL_ELEMENT_POINTER;
+    EXPECT_PASS(ensure_unshared(self));
+    STATS_OP(self, LL_OP_PUSH_FRONT);
+    if (self->reversed) return push_tail(self, elem);
+    return push_head(self, elem);
+}
+
+ll_Error ll_push_front(ll_LinkedList *self, void *elem) {
+    TRACED(LL_OP_PUSH_FRONT, self, -1, push_front_impl(self, elem));
+}
+
 
 /// param out_elem: node element is written to it, or ignored if NULL.
 /// @returns LL_OK
 ///     || LL_ERROR_NULL_LINKED_LIST_POINTER
 ///     || LL_ERROR_EMPTY_LINKED_LIST
 ///     || LL_ERROR_INTERNAL
-ll_Error ll_pop(ll_LinkedList *self, void *out_elem) {
+static ll_Error pop_tail(ll_LinkedList *self, void *out_elem) {
     if (self == NULL) return LL_ERROR_NULL_LINKED_LIST_POINTER;
     if (ll_is_empty(self)) return LL_ERROR_EMPTY_LINKED_LIST;
     if (self->head == NULL || self->tail == NULL) ERROR_RETURN(LL_ERROR_INTERNAL);
     if (!EXPECT_S(has_valid_head_tail_state, self, bool)) ERROR_RETURN(LL_ERROR_INTERNAL);
+    EXPECT_PASS(ensure_unshared(self));
     
     // copy node data to out_elem if not NULL
     struct ll_LinkedListNode *node = self->tail;
-    if (out_elem != NULL) memcpy(out_elem, self->tail->data, self->data_size);
+    if (out_elem != NULL) {
+        memcpy(out_elem, self->tail->data, self->data_size);
+        STATS_ADD(self, bytes_copied, self->data_size);
+    }
 
     if (self->head == self->tail) {
         // empty after a pop
@@ -189,23 +487,40 @@ ll_Error ll_pop(ll_LinkedList *self, void *out_elem) {
     if (self->len <= 0) ERROR_RETURN(LL_ERROR_INTERNAL);
     self->len--;
 
-    free(node);
+    node_free(self, node);
     return LL_OK;
 }
 
+static inline ll_Error pop_impl(ll_LinkedList *self, void *out_elem) {
+    if (self == NULL) return LL_ERROR_NULL_LINKED_LIST_POINTER;
+    if (ll_is_empty(self)) return LL_ERROR_EMPTY_LINKED_LIST;
+    EXPECT_PASS(ensure_unshared(self));
+    STATS_OP(self, LL_OP_POP);
+    if (self->reversed) return pop_head(self, out_elem);
+    return pop_tail(self, out_elem);
+}
+
+ll_Error ll_pop(ll_LinkedList *self, void *out_elem) {
+    TRACED(LL_OP_POP, self, -1, pop_impl(self, out_elem));
+}
+
 
 /// @param out_elem  node element is written to it, or ignored if NULL.
 /// @returns LL_OK
 ///     || LL_ERROR_NULL_LINKED_LIST_POINTER
 ///     || LL_ERROR_EMPTY_LINKED_LIST
 ///     || LL_ERROR_INTERNAL
-ll_Error ll_pop_front(ll_LinkedList *self, void *out_elem) {
+static ll_Error pop_head(ll_LinkedList *self, void *out_elem) {
     if (self == NULL) return LL_ERROR_NULL_LINKED_LIST_POINTER;
     if (ll_is_empty(self)) return LL_ERROR_EMPTY_LINKED_LIST;
+    EXPECT_PASS(ensure_unshared(self));
     
     // copy node data to out_elem if not NULL
     struct ll_LinkedListNode *node = self->head;
-    if (out_elem != NULL) memcpy(out_elem, node->data, self->data_size);
+    if (out_elem != NULL) {
+        memcpy(out_elem, node->data, self->data_size);
+        STATS_ADD(self, bytes_copied, self->data_size);
+    }
 
     if (self->head == self->tail) {
         // empty after a pop
@@ -216,179 +531,1378 @@ ll_Error ll_pop_front(ll_LinkedList *self, void *out_elem) {
         self->head = self->head->next;
         self->head->prev = NULL;
     }
-    
-    if (self->len <= 0) ERROR_RETURN(LL_ERROR_INTERNAL);
-    self->len--;
+    
+    if (self->len <= 0) ERROR_RETURN(LL_ERROR_INTERNAL);
+    self->len--;
+
+    node_free(self, node);
+    return LL_OK;
+}
+
+static inline ll_Error pop_front_impl(ll_LinkedList *self, void *out_elem) {
+    if (self == NULL) return LL_ERROR_NULL_LINKED_LIST_POINTER;
+    if (ll_is_empty(self)) return LL_ERROR_EMPTY_LINKED_LIST;
+    EXPECT_PASS(ensure_unshared(self));
+    STATS_OP(self, LL_OP_POP_FRONT);
+    if (self->reversed) return pop_tail(self, out_elem);
+    return pop_head(self, out_elem);
+}
+
+ll_Error ll_pop_front(ll_LinkedList *self, void *out_elem) {
+    TRACED(LL_OP_POP_FRONT, self, -1, pop_front_impl(self, out_elem));
+}
+
+
+/// returns the node #index steps from the head, walking from the closer end. #index must be in bounds.
+static struct ll_LinkedListNode* node_at(const ll_LinkedList *self, size_t index) {
+    struct ll_LinkedListNode *target = NULL;
+    if (self->len - 1 - index < index) {
+        // better iterate in reverse since the distance from tail is shorter
+        STATS_ADD(self, tail_traversals, 1);
+        STATS_ADD(self, traversal_steps, self->len - 1 - index);
+        target = self->tail;
+        for (size_t i = self->len - 1; i > index && target != NULL; i--) target = target->prev;
+    } else {
+        STATS_ADD(self, traversal_steps, index);
+        // iterate from head
+        target = self->head;
+        for (size_t i = 0; i < index && target != NULL; i++) target = target->next;
+    }
+    return target;
+}
+
+
+/// determines the shortest path from head to index or tail to index and iterates through it
+/// the node at the index is written to out_node. in a reversed list (see ll_reverse) the element after it is
+/// reached through its prev link.
+/// @returns LL_OK
+///     || LL_ERROR_NULL_LINKED_LIST_POINTER
+///     || LL_ERROR_NULL_NODE_POINTER
+///     || LL_ERROR_EMPTY_LINKED_LIST
+///     || LL_ERROR_INDEX_OUT_OF_BOUNDS
+///     || LL_ERROR_INTERNAL
+static ll_Error iterate_to_impl(const ll_LinkedList *self, struct ll_LinkedListNode **out_node, size_t index) {
+    if (self == NULL) return LL_ERROR_NULL_LINKED_LIST_POINTER;
+    if (out_node == NULL) return LL_ERROR_NULL_NODE_POINTER;
+    if (ll_is_empty(self)) return LL_ERROR_EMPTY_LINKED_LIST;
+    if (!EXPECT_S(is_index_within_get_bounds, self, bool, index)) return LL_ERROR_INDEX_OUT_OF_BOUNDS;
+    if (!EXPECT_S(has_valid_head_tail_state, self, bool)) ERROR_RETURN(LL_ERROR_INTERNAL);
+
+    STATS_OP(self, LL_OP_ITERATE);
+
+    // iterate to target node to retrieve
+    struct ll_LinkedListNode *target = node_at(self, self->reversed ? self->len - 1 - index : index);
+    if (target == NULL) ERROR_RETURN(LL_ERROR_INTERNAL);
+    *out_node = target;
+    return LL_OK;
+}
+
+ll_Error iterate_to64(const ll_LinkedList *self, struct ll_LinkedListNode **out_node, size_t index) {
+    TRACED(LL_OP_ITERATE, self, (i64)index, iterate_to_impl(self, out_node, index));
+}
+
+ll_Error iterate_to(const ll_LinkedList *self, struct ll_LinkedListNode **out_node, int index) {
+    return iterate_to64(self, out_node, index64(index));
+}
+
+
+/// traverses to the nth node (unless it's tail or head) and left-inserts a node with the element content at
+/// the given index.
+/// @param index must be within the raneg [0..self->len()] where self->len() indicates a tail insert.
+/// @returns LL_OK
+///     || LL_ERROR_NULL_LINKED_LIST_POINTER
+///     || LL_ERROR_NULL_ELEMENT_POINTER
+///     || LL_ERROR_INDEX_OUT_OF_BOUNDS
+///     || LL_ERROR_MALLOC_FAILURE
+///     || LL_ERROR_INTERNAL
+static ll_Error insert_impl(ll_LinkedList *self, size_t index, void *elem) {
+    if (self == NULL) return LL_ERROR_NULL_LINKED_LIST_POINTER;
+    if (elem == NULL) return LL_ERROR_NULL_ELEMENT_POINTER;
+    if (!EXPECT_S(is_index_within_insert_bounds, self, bool, index)) return LL_ERROR_INDEX_OUT_OF_BOUNDS;
+    EXPECT_PASS(ensure_unshared(self));
+    STATS_OP(self, LL_OP_INSERT);
+    
+    if (self->len == 0 || index == self->len) {
+        // one element, or at the end. Both of those insertions are handled with a push to tail. the physical
+        // ends are called directly since push_impl would count the insert a second time as a push
+        EXPECT_PASS(self->reversed ? push_head(self, elem) : push_tail(self, elem));
+    }
+    else if (index == 0) {
+        // insertion in the front, but this is not an empty linkedlist, that's a front push
+        EXPECT_PASS(self->reversed ? push_tail(self, elem) : push_head(self, elem));
+    }
+    else {
+        // traverse to node to insert at
+        struct ll_LinkedListNode *target_node = NULL; 
+        ll_Error status = iterate_to_impl(self, &target_node, index);
+        if (status != LL_OK) ERROR_RETURN(LL_ERROR_INTERNAL);
+        if (target_node == NULL) ERROR_RETURN(LL_ERROR_INTERNAL);
+
+        // insert new node to the left of #target_node at index, its right in a reversed list
+        struct ll_LinkedListNode *node = node_alloc(self);
+        if (node == NULL) ERROR_RETURN(LL_ERROR_MALLOC_FAILURE);
+        memcpy(node->data, elem, self->data_size);
+        if (self->reversed) {
+            node->prev = target_node;
+            node->next = target_node->next;
+            target_node->next->prev = node;
+            target_node->next = node;
+        } else {
+            node->next = target_node;
+            node->prev = target_node->prev;
+            target_node->prev->next = node;
+            target_node->prev = node;
+        }
+        self->len++;
+        STATS_ADD(self, bytes_copied, self->data_size);
+        STATS_TRACK_LEN(self);
+    }
+
+    return LL_OK;
+}
+
+ll_Error ll_insert64(ll_LinkedList *self, size_t index, void *elem) {
+    TRACED(LL_OP_INSERT, self, (i64)index, insert_impl(self, index, elem));
+}
+
+ll_Error ll_insert(ll_LinkedList *self, int index, void *elem) {
+    return ll_insert64(self, index64(index), elem);
+}
+
+
+/// traverses to the nth node (unless it's a tail or head) and sets the data of that node to the content of #elem.
+/// @param index must be within the range [0..self->len())
+/// @returns LL_OK
+///     || LL_ERROR_NULL_LINKED_LIST_POINTER
+///     || LL_ERROR_NULL_ELEMENT_POINTER
+///     || LL_ERROR_INDEX_OUT_OF_BOUNDS
+///     || LL_ERROR_INTERNAL
+static ll_Error set_impl(ll_LinkedList *self, size_t index, void *elem) {
+    if (self == NULL) return LL_ERROR_NULL_LINKED_LIST_POINTER;
+    if (elem == NULL) return LL_ERROR_NULL_ELEMENT_POINTER;
+    if (!EXPECT_S(is_index_within_get_bounds, self, bool, index)) return LL_ERROR_INDEX_OUT_OF_BOUNDS;
+    if (!EXPECT_S(has_valid_head_tail_state, self, bool)) ERROR_RETURN(LL_ERROR_INTERNAL);
+    EXPECT_PASS(ensure_unshared(self));
+    STATS_OP(self, LL_OP_SET);
+
+    // iterate to target node to retrieve (or error return)
+    struct ll_LinkedListNode *target = EXPECT_S(iterate_to_impl, self, struct ll_LinkedListNode*, index);
+
+    // retrieve target node data
+    if (target == NULL) ERROR_RETURN(LL_ERROR_INTERNAL);
+    memcpy(target->data, elem, self->data_size);
+    STATS_ADD(self, bytes_copied, self->data_size);
+    
+    return LL_OK;
+}
+
+ll_Error ll_set64(ll_LinkedList *self, size_t index, void *elem) {
+    TRACED(LL_OP_SET, self, (i64)index, set_impl(self, index, elem));
+}
+
+ll_Error ll_set(ll_LinkedList *self, int index, void *elem) {
+    return ll_set64(self, index64(index), elem);
+}
+
+/// retrieves the data in a node at an index without removing that node.
+/// it's preferable to iterate rather than use this function as it's O(n)
+/// @param out_elem node data to be gotten.
+/// @returns LL_OK
+///     || LL_ERROR_NULL_LINKED_LIST_POINTER
+///     || LL_ERROR_NULL_ELEMENT_POINTER
+///     || LL_ERROR_EMPTY_LINKED_LIST,
+///     || LL_ERROR_INDEX_OUT_OF_BOUNDS
+///     || LL_ERROR_INTERNAL
+static ll_Error get_impl(const ll_LinkedList *self, void *out_elem, size_t index) {
+    if (self == NULL) return LL_ERROR_NULL_LINKED_LIST_POINTER;
+    if (out_elem == NULL) return LL_ERROR_NULL_ELEMENT_POINTER;
+    if (ll_is_empty(self)) return LL_ERROR_EMPTY_LINKED_LIST;
+    if (!EXPECT_S(is_index_within_get_bounds, self, bool, index)) return LL_ERROR_INDEX_OUT_OF_BOUNDS;
+    STATS_OP(self, LL_OP_GET);
+
+    // iterate to target node to retrieve (or error return)
+    struct ll_LinkedListNode *target = EXPECT_S(iterate_to_impl, self, struct ll_LinkedListNode*, index);
+
+    // retrieve target node data
+    if (target == NULL) ERROR_RETURN(LL_ERROR_INTERNAL);
+    memcpy(out_elem, target->data, self->data_size);
+    STATS_ADD(self, bytes_copied, self->data_size);
+    
+    return LL_OK;
+}
+
+ll_Error ll_get64(const ll_LinkedList *self, void *out_elem, size_t index) {
+    TRACED(LL_OP_GET, self, (i64)index, get_impl(self, out_elem, index));
+}
+
+ll_Error ll_get(const ll_LinkedList *self, void *out_elem, int index) {
+    return ll_get64(self, out_elem, index64(index));
+}
+
+
+/// @param out_elem data of removed element to be written. if NULL, it's discarded.
+/// @param index must be [0..self->len) 
+/// @returns LL_OK
+///     || LL_ERROR_NULL_LINKED_LIST_POINTER
+///     || LL_ERROR_EMPTY_LINKED_LIST
+///     || LL_ERROR_INDEX_OUT_OF_BOUNDS
+///     || LL_ERROR_INTERNAL
+static ll_Error remove_impl(ll_LinkedList *self, void *out_elem, size_t index) {
+    if (self == NULL) return LL_ERROR_NULL_LINKED_LIST_POINTER;
+    if (ll_is_empty(self)) return LL_ERROR_EMPTY_LINKED_LIST;
+    if (!EXPECT_S(is_index_within_get_bounds, self, bool, index)) return LL_ERROR_INDEX_OUT_OF_BOUNDS;
+    EXPECT_PASS(ensure_unshared(self));
+    STATS_OP(self, LL_OP_REMOVE);
+
+    if (self->len == 1 || index == self->len-1) {
+        EXPECT_PASS(self->reversed ? pop_head(self, out_elem) : pop_tail(self, out_elem));
+    }
+    else if (index == 0) {
+        EXPECT_PASS(self->reversed ? pop_tail(self, out_elem) : pop_head(self, out_elem));
+    }
+    else {
+        struct ll_LinkedListNode *target = EXPECT_S(iterate_to_impl, self, struct ll_LinkedListNode*, index);
+
+        // link the target's prev with next as it must be a middle node
+        if (target == NULL) ERROR_RETURN(LL_ERROR_INTERNAL);
+        if (target->prev == NULL || target->next == NULL) ERROR_RETURN(LL_ERROR_INTERNAL);
+        target->prev->next = target->next;
+        target->next->prev = target->prev;
+
+        if (out_elem != NULL) {
+            memcpy(out_elem, target->data, self->data_size);
+            STATS_ADD(self, bytes_copied, self->data_size);
+        }
+        node_free(self, target);
+        self->len--;
+    }
+
+    return LL_OK;
+}
+
+ll_Error ll_remove64(ll_LinkedList *self, void *out_elem, size_t index) {
+    TRACED(LL_OP_REMOVE, self, (i64)index, remove_impl(self, out_elem, index));
+}
+
+ll_Error ll_remove(ll_LinkedList *self, void *out_elem, int index) {
+    return ll_remove64(self, out_elem, index64(index));
+}
+
+
+
+// ----------------------------------------------------------------------------------------------------------
+// Batched Edits---------------------------------------------------------------------------------------------
+// ----------------------------------------------------------------------------------------------------------
+/* every index of a batch refers to a position in the list as it was before the batch, so the edits don't shift
+ * each other. the edits are sorted by index and applied in one pass from the head.
+ */
+
+// an edit of a batch: its index and its position in the caller's arrays
+typedef struct {
+    int index;
+    u32 pos;
+}BatchEdit;
+
+static int compare_batch_edits(const void *a, const void *b) {
+    const BatchEdit *x = a, *y = b;
+    if (x->index != y->index) return x->index < y->index ? -1 : 1;
+    // ties keep the caller's order
+    return x->pos < y->pos ? -1 : (x->pos > y->pos);
+}
+
+/// returns the edits of #indices sorted by index, or NULL on failure. the caller frees it.
+static BatchEdit* sort_batch(const int *indices, u32 k) {
+    BatchEdit *edits = malloc(sizeof(BatchEdit) * k);
+    if (edits == NULL) return NULL;
+    for (u32 i = 0; i < k; i++) edits[i] = (BatchEdit){.index = indices[i], .pos = i};
+    qsort(edits, k, sizeof(BatchEdit), compare_batch_edits);
+    return edits;
+}
+
+static ll_Error insert_many_impl(ll_LinkedList *self, const int *indices, const void *elems, u32 k) {
+    if (self == NULL) return LL_ERROR_NULL_LINKED_LIST_POINTER;
+    if (k == 0) return LL_OK;
+    if (indices == NULL || elems == NULL) return LL_ERROR_NULL_ELEMENT_POINTER;
+    for (u32 i = 0; i < k; i++) {
+        if (indices[i] < 0 || (size_t)indices[i] > self->len) return LL_ERROR_INDEX_OUT_OF_BOUNDS;
+    }
+    EXPECT_PASS(ensure_unshared(self));
+    EXPECT_PASS(ensure_forward(self));
+
+    BatchEdit *edits = sort_batch(indices, k);
+    if (edits == NULL) ERROR_RETURN(LL_ERROR_MALLOC_FAILURE);
+    u8 *run = ll_pool_alloc_run(&self->pool, k);
+    if (run == NULL) {
+        free(edits);
+        ERROR_RETURN(LL_ERROR_MALLOC_FAILURE);
+    }
+    STATS_ADD(self, node_allocs, k);
+    STATS_ADD(self, bytes_copied, (u64)k * self->data_size);
+
+    // #next is the node at original index #pos, new nodes go right before it
+    struct ll_LinkedListNode *next = self->head;
+    size_t pos = 0;
+    for (u32 i = 0; i < k; i++) {
+        for (; pos < (size_t)edits[i].index; pos++) next = next->next;
+
+        struct ll_LinkedListNode *node = (struct ll_LinkedListNode*)(run + (size_t)i * self->pool.node_size);
+        memcpy(node->data, (const u8*)elems + (size_t)edits[i].pos * self->data_size, self->data_size);
+        node->next = next;
+        node->prev = next != NULL ? next->prev : self->tail;
+        if (node->prev == NULL) self->head = node;
+        else node->prev->next = node;
+        if (next == NULL) self->tail = node;
+        else next->prev = node;
+    }
+    STATS_ADD(self, traversal_steps, pos);
+    self->len += k;
+    STATS_TRACK_LEN(self);
+
+    free(edits);
+    return LL_OK;
+}
+
+/// inserts #k elements in a single pass. elems[j] (of #self->data_size bytes) goes right before the element at
+/// indices[j] of the list as it was before the call, or at the tail if indices[j] is its length. elements
+/// inserted at the same index keep their order in #elems. the new nodes are allocated in a single run.
+/// nothing is inserted on failure.
+/// @returns LL_OK
+///     || LL_ERROR_NULL_LINKED_LIST_POINTER
+///     || LL_ERROR_NULL_ELEMENT_POINTER
+///     || LL_ERROR_INDEX_OUT_OF_BOUNDS
+///     || LL_ERROR_MALLOC_FAILURE
+ll_Error ll_insert_many_at(ll_LinkedList *self, const int *indices, const void *elems, u32 k) {
+    TRACED(LL_OP_INSERT, self, -1, insert_many_impl(self, indices, elems, k));
+}
+
+
+static ll_Error remove_many_impl(ll_LinkedList *self, const int *indices, void *out, u32 k) {
+    if (self == NULL) return LL_ERROR_NULL_LINKED_LIST_POINTER;
+    if (k == 0) return LL_OK;
+    if (indices == NULL) return LL_ERROR_NULL_ELEMENT_POINTER;
+    for (u32 i = 0; i < k; i++) {
+        if (indices[i] < 0 || (size_t)indices[i] >= self->len) return LL_ERROR_INDEX_OUT_OF_BOUNDS;
+    }
+
+    BatchEdit *edits = sort_batch(indices, k);
+    if (edits == NULL) ERROR_RETURN(LL_ERROR_MALLOC_FAILURE);
+    for (u32 i = 1; i < k; i++) {
+        if (edits[i].index == edits[i - 1].index) {
+            free(edits);
+            return LL_ERROR_INDEX_OUT_OF_BOUNDS;
+        }
+    }
+    ll_Error status = ensure_unshared(self);
+    if (status == LL_OK) status = ensure_forward(self);
+    if (status != LL_OK) {
+        free(edits);
+        ERROR_RETURN(status);
+    }
+
+    // #node is the node at original index #pos
+    struct ll_LinkedListNode *node = self->head;
+    size_t pos = 0;
+    for (u32 i = 0; i < k; i++) {
+        for (; pos < (size_t)edits[i].index; pos++) node = node->next;
+
+        if (out != NULL) {
+            memcpy((u8*)out + (size_t)edits[i].pos * self->data_size, node->data, self->data_size);
+            STATS_ADD(self, bytes_copied, self->data_size);
+        }
+        struct ll_LinkedListNode *next = node->next;
+        if (node->prev == NULL) self->head = next;
+        else node->prev->next = next;
+        if (next == NULL) self->tail = node->prev;
+        else next->prev = node->prev;
+        node_free(self, node);
+        node = next;
+        pos++;
+    }
+    STATS_ADD(self, traversal_steps, pos);
+    self->len -= k;
+
+    free(edits);
+    return LL_OK;
+}
+
+/// removes #k elements in a single pass. indices[j] is the index of an element in the list as it was before the
+/// call, and it's copied to out[j] (#self->data_size bytes each) unless #out is NULL.
+/// nothing is removed on failure.
+/// @returns LL_OK
+///     || LL_ERROR_NULL_LINKED_LIST_POINTER
+///     || LL_ERROR_NULL_ELEMENT_POINTER
+///     || LL_ERROR_INDEX_OUT_OF_BOUNDS if an index is out of bounds or repeated
+///     || LL_ERROR_MALLOC_FAILURE
+ll_Error ll_remove_many_at(ll_LinkedList *self, const int *indices, void *out, u32 k) {
+    TRACED(LL_OP_REMOVE, self, -1, remove_many_impl(self, indices, out, k));
+}
+
+
+// ----------------------------------------------------------------------------------------------------------
+// Bulk Copy-------------------------------------------------------------------------------------------------
+// ----------------------------------------------------------------------------------------------------------
+
+/// copies the payloads of #count elements from #node onwards to the contiguous #dst.
+/// the common element sizes get a fixed size copy that compiles to plain loads and stores.
+static void copy_out(const ll_LinkedList *self, const struct ll_LinkedListNode *node, size_t count, u8 *dst) {
+    const u32 size = self->data_size;
+    if (self->reversed) {
+        for (size_t i = 0; i < count; i++, node = node->prev, dst += size) memcpy(dst, node->data, size);
+        STATS_ADD(self, bytes_copied, (u64)count * size);
+        return;
+    }
+    switch (size) {
+    case 4:
+        for (size_t i = 0; i < count; i++, node = node->next, dst += 4) memcpy(dst, node->data, 4);
+        break;
+    case 8:
+        for (size_t i = 0; i < count; i++, node = node->next, dst += 8) memcpy(dst, node->data, 8);
+        break;
+    default:
+        for (size_t i = 0; i < count; i++, node = node->next, dst += size) memcpy(dst, node->data, size);
+        break;
+    }
+    STATS_ADD(self, bytes_copied, (u64)count * size);
+}
+
+
+/// copies the #count elements from index #from onwards to #dst, which holds #count * #self->data_size bytes.
+/// the first element is found from the closer end and the rest are copied in a single forward walk.
+/// @returns LL_OK
+///     || LL_ERROR_NULL_LINKED_LIST_POINTER
+///     || LL_ERROR_NULL_ELEMENT_POINTER
+///     || LL_ERROR_INDEX_OUT_OF_BOUNDS if the range doesn't fit in the list
+ll_Error ll_copy_range(const ll_LinkedList *self, size_t from, size_t count, void *dst) {
+    if (self == NULL) return LL_ERROR_NULL_LINKED_LIST_POINTER;
+    if (from > self->len || count > self->len - from) return LL_ERROR_INDEX_OUT_OF_BOUNDS;
+    if (count == 0) return LL_OK;
+    if (dst == NULL) return LL_ERROR_NULL_ELEMENT_POINTER;
+
+    struct ll_LinkedListNode *node = EXPECT_S(iterate_to_impl, self, struct ll_LinkedListNode*, from);
+    copy_out(self, node, count, dst);
+    return LL_OK;
+}
+
+
+/// copies every element to #dst, which holds #self->len * #self->data_size bytes.
+/// @returns LL_OK
+///     || LL_ERROR_NULL_LINKED_LIST_POINTER
+///     || LL_ERROR_NULL_ELEMENT_POINTER
+ll_Error ll_to_array(const ll_LinkedList *self, void *dst) {
+    if (self == NULL) return LL_ERROR_NULL_LINKED_LIST_POINTER;
+    if (self->len == 0) return LL_OK;
+    if (dst == NULL) return LL_ERROR_NULL_ELEMENT_POINTER;
+    copy_out(self, first_node(self), self->len, dst);
+    return LL_OK;
+}
+
+
+/// creates a list of the #count elements of #data_size bytes in #src. its nodes are allocated in a single run.
+/// returns NULL on failure
+ll_LinkedList* ll_from_array(u32 data_size, const void *src, size_t count) {
+    if (src == NULL && count > 0) return NULL;
+    ll_LinkedList *out = ll_new(data_size);
+    if (out == NULL || count == 0) return out;
+
+    u8 *run = ll_pool_alloc_run(&out->pool, count);
+    if (run == NULL) {
+        ll_free(&out);
+        return NULL;
+    }
+    const size_t stride = out->pool.node_size;
+    const u8 *cur = src;
+    for (size_t i = 0; i < count; i++, cur += data_size) {
+        memcpy(((struct ll_LinkedListNode*)(run + i * stride))->data, cur, data_size);
+    }
+    link_run(out, run, count);
+    STATS_ADD(out, bytes_copied, (u64)count * data_size);
+    return out;
+}
+
+
+/// creates a copy of the list with the same allocator, and the same inline storage if it was made with
+/// ll_new_small. the nodes of the copy are allocated in a single run and filled in one pass.
+/// returns NULL on failure
+ll_LinkedList* ll_clone(const ll_LinkedList *self) {
+    if (self == NULL) return NULL;
+    const struct ll_PoolSlab *inline_slab = self->pool.inline_slab;
+    ll_LinkedList *out = new_list(self->data_size, inline_slab != NULL ? inline_slab->capacity : 0,
+                                  self->pool.alloc, self->pool.alloc_ctx);
+    if (out == NULL) return NULL;
+
+    struct ll_LinkedListNode *head, *tail;
+    if (copy_nodes(self, &out->pool, &head, &tail) != LL_OK) {
+        ll_free(&out);
+        return NULL;
+    }
+    out->head = head;
+    out->tail = tail;
+    out->len = self->len;
+    STATS_TRACK_LEN(out);
+    return out;
+}
+
+
+// ----------------------------------------------------------------------------------------------------------
+// Merging---------------------------------------------------------------------------------------------------
+// ----------------------------------------------------------------------------------------------------------
+/* sorted lists are merged by relinking their nodes into the destination, whose pool adopts the slabs of the
+ * sources. nodes are only copied when they can't change hands: those of a source with another allocator, and
+ * those in the inline slab of a small list. the copies are reserved in a single run before anything is relinked,
+ * so a merge either completes or leaves every list as it was.
+ * the next node of every source sits in a binary heap, ties going to the earlier source so that merges are stable.
+ */
+
+// a source of a merge: its next node, its position among the sources and whether its nodes must be copied
+typedef struct {
+    struct ll_LinkedListNode *node;
+    u32 list;
+    bool copy_all;
+    // set if some nodes are in the source's inline slab
+    const ll_NodePool *inline_pool;
+}MergeHead;
+
+// merges of up to this many lists keep their heap on the stack
+#define LL_MERGE_STACK_LISTS 16
+
+static inline bool merge_head_less(const MergeHead *a, const MergeHead *b, ll_CompareFn cmp) {
+    int order = cmp(a->node->data, b->node->data);
+    return order < 0 || (order == 0 && a->list < b->list);
+}
+
+static void merge_sift_down(MergeHead *heap, u32 count, u32 i, ll_CompareFn cmp) {
+    MergeHead top = heap[i];
+    for (;;) {
+        u32 child = 2 * i + 1;
+        if (child >= count) break;
+        if (child + 1 < count && merge_head_less(&heap[child + 1], &heap[child], cmp)) child++;
+        if (!merge_head_less(&heap[child], &top, cmp)) break;
+        heap[i] = heap[child];
+        i = child;
+    }
+    heap[i] = top;
+}
+
+/// returns how many nodes of #src may have to be copied rather than relinked into #dst.
+static size_t merge_copies(const ll_LinkedList *dst, const ll_LinkedList *src) {
+    if (src == dst) return 0;
+    if (!ll_pool_can_adopt(&dst->pool, &src->pool)) return src->len;
+    const struct ll_PoolSlab *slab = src->pool.inline_slab;
+    if (slab == NULL) return 0;
+    return slab->capacity < src->len ? slab->capacity : src->len;
+}
+
+/// gives what's left of #src's pool to #dst, or releases it, and empties #src.
+static void merge_release(ll_LinkedList *dst, ll_LinkedList *src) {
+    if (ll_pool_can_adopt(&dst->pool, &src->pool)) {
+        ll_pool_adopt(&dst->pool, &src->pool);
+    } else {
+        struct ll_PoolSlab *inline_slab = ll_pool_detach_inline(&src->pool);
+        ll_pool_destroy(&src->pool);
+        if (inline_slab != NULL) ll_pool_add_inline(&src->pool, inline_slab, inline_slab->capacity);
+    }
+    src->head = NULL;
+    src->tail = NULL;
+    src->len = 0;
+}
+
+static int compare_list_pointers(const void *a, const void *b) {
+    uintptr_t x = (uintptr_t)*(ll_LinkedList *const *)a, y = (uintptr_t)*(ll_LinkedList *const *)b;
+    return (x > y) - (x < y);
+}
+
+/// checks that no list is passed twice, which would link its nodes twice. few lists are compared pairwise,
+/// more are sorted in a copy of #lists.
+/// @returns LL_OK || LL_ERROR_UNSUPPORTED || LL_ERROR_MALLOC_FAILURE
+static ll_Error check_distinct(ll_LinkedList *const *lists, u32 k) {
+    if (k <= LL_MERGE_STACK_LISTS) {
+        for (u32 i = 1; i < k; i++) {
+            for (u32 j = 0; j < i; j++) {
+                if (lists[i] == lists[j]) return LL_ERROR_UNSUPPORTED;
+            }
+        }
+        return LL_OK;
+    }
+
+    ll_LinkedList **sorted = malloc(sizeof(ll_LinkedList*) * k);
+    if (sorted == NULL) ERROR_RETURN(LL_ERROR_MALLOC_FAILURE);
+    memcpy(sorted, lists, sizeof(ll_LinkedList*) * k);
+    qsort(sorted, k, sizeof(ll_LinkedList*), compare_list_pointers);
+    ll_Error status = LL_OK;
+    for (u32 i = 1; i < k && status == LL_OK; i++) {
+        if (sorted[i] == sorted[i - 1]) status = LL_ERROR_UNSUPPORTED;
+    }
+    free(sorted);
+    return status;
+}
+
+static ll_Error merge_impl(ll_LinkedList *dst, ll_LinkedList *const *lists, u32 k, ll_CompareFn cmp) {
+    if (dst == NULL) return LL_ERROR_NULL_LINKED_LIST_POINTER;
+    if (cmp == NULL || (lists == NULL && k > 0)) return LL_ERROR_NULL_ELEMENT_POINTER;
+    for (u32 i = 0; i < k; i++) {
+        if (lists[i] == NULL) return LL_ERROR_NULL_LINKED_LIST_POINTER;
+        if (lists[i]->data_size != dst->data_size) return LL_ERROR_UNSUPPORTED;
+    }
+    ll_Error status = check_distinct(lists, k);
+    if (status != LL_OK) return status;
+    EXPECT_PASS(ensure_unshared(dst));
+    EXPECT_PASS(ensure_forward(dst));
+    size_t copies = 0;
+    for (u32 i = 0; i < k; i++) {
+        EXPECT_PASS(ensure_unshared(lists[i]));
+        EXPECT_PASS(ensure_forward(lists[i]));
+        copies += merge_copies(dst, lists[i]);
+    }
+
+    MergeHead stack_heap[LL_MERGE_STACK_LISTS];
+    MergeHead *heap = stack_heap;
+    if (k > LL_MERGE_STACK_LISTS) {
+        heap = malloc(sizeof(MergeHead) * k);
+        if (heap == NULL) ERROR_RETURN(LL_ERROR_MALLOC_FAILURE);
+    }
+    u8 *run = NULL;
+    if (copies > 0) {
+        run = ll_pool_alloc_run(&dst->pool, copies);
+        if (run == NULL) {
+            if (heap != stack_heap) free(heap);
+            ERROR_RETURN(LL_ERROR_MALLOC_FAILURE);
+        }
+    }
+
+    // when #dst is a source its nodes are relinked like the others, otherwise they stay in front
+    u32 count = 0;
+    size_t merged = 0;
+    for (u32 i = 0; i < k; i++) {
+        ll_LinkedList *src = lists[i];
+        if (src->len == 0) continue;
+        bool foreign = src != dst && !ll_pool_can_adopt(&dst->pool, &src->pool);
+        heap[count++] = (MergeHead){
+            .node = src->head,
+            .list = i,
+            .copy_all = foreign,
+            .inline_pool = !foreign && src != dst && src->pool.inline_slab != NULL ? &src->pool : NULL,
+        };
+        merged += src->len;
+    }
+    for (u32 i = 0; i < k; i++) {
+        if (lists[i] == dst) {
+            dst->head = NULL;
+            dst->tail = NULL;
+            dst->len = 0;
+        }
+    }
+    for (u32 i = count / 2; i-- > 0;) merge_sift_down(heap, count, i, cmp);
+
+    const size_t stride = dst->pool.node_size;
+    size_t used = 0;
+    struct ll_LinkedListNode *tail = dst->tail;
+    while (count > 0) {
+        struct ll_LinkedListNode *node = heap[0].node;
+        if (heap[0].copy_all || (heap[0].inline_pool != NULL && ll_pool_is_inline(heap[0].inline_pool, node))) {
+            struct ll_LinkedListNode *copy = (struct ll_LinkedListNode*)(run + used++ * stride);
+            memcpy(copy->data, node->data, dst->data_size);
+            heap[0].node = node->next;
+            node = copy;
+        } else {
+            heap[0].node = node->next;
+        }
+        if (heap[0].node == NULL) heap[0] = heap[--count];
+        if (count > 1) merge_sift_down(heap, count, 0, cmp);
+
+        node->prev = tail;
+        if (tail == NULL) dst->head = node;
+        else tail->next = node;
+        tail = node;
+    }
+    if (tail != NULL) tail->next = NULL;
+    dst->tail = tail;
+    dst->len += merged;
+    STATS_ADD(dst, node_allocs, used);
+    STATS_ADD(dst, bytes_copied, (u64)used * dst->data_size);
+    STATS_TRACK_LEN(dst);
+
+    // the reserved copies that went unused are recycled
+    for (size_t i = used; i < copies; i++) ll_pool_free(&dst->pool, run + i * stride);
+    for (u32 i = 0; i < k; i++) {
+        if (lists[i] != dst) merge_release(dst, lists[i]);
+    }
+    if (heap != stack_heap) free(heap);
+    return LL_OK;
+}
+
+
+/// merges the sorted lists #a and #b into #dst in O(len) by relinking their nodes, #a and #b are left empty.
+/// #dst may be #a or #b, otherwise the merged elements are appended to it. equal elements keep their order, those
+/// of #a first. nodes are only copied when #dst can't take them over: when a list has another allocator than
+/// #dst, or for the inline nodes of a list made with ll_new_small. nothing changes on failure.
+/// @param cmp orders two elements like qsort's comparator.
+/// @returns LL_OK
+///     || LL_ERROR_NULL_LINKED_LIST_POINTER
+///     || LL_ERROR_NULL_ELEMENT_POINTER if #cmp is NULL
+///     || LL_ERROR_UNSUPPORTED if the lists hold elements of different sizes, or #a and #b are the same list
+///     || LL_ERROR_MALLOC_FAILURE
+ll_Error ll_merge(ll_LinkedList *dst, ll_LinkedList *a, ll_LinkedList *b, ll_CompareFn cmp) {
+    ll_LinkedList *lists[] = {a, b};
+    return merge_impl(dst, lists, 2, cmp);
+}
+
+
+/// merges the #k sorted #lists into #dst in O(n log k) with a heap of their next nodes, as ll_merge does for two.
+/// #dst may be one of the lists, each list at most once. equal elements keep the order of #lists.
+/// the heap is only allocated for more than 16 lists.
+/// @returns LL_OK
+///     || LL_ERROR_NULL_LINKED_LIST_POINTER
+///     || LL_ERROR_NULL_ELEMENT_POINTER if #lists or #cmp is NULL
+///     || LL_ERROR_UNSUPPORTED if the lists hold elements of different sizes, or a list is passed twice
+///     || LL_ERROR_MALLOC_FAILURE
+ll_Error ll_merge_k(ll_LinkedList *dst, ll_LinkedList *const *lists, u32 k, ll_CompareFn cmp) {
+    return merge_impl(dst, lists, k, cmp);
+}
+
+
+// ----------------------------------------------------------------------------------------------------------
+// Transforms------------------------------------------------------------------------------------------------
+// ----------------------------------------------------------------------------------------------------------
+
+/// reverses the order of the elements in O(1). no node is touched, the list only swaps its ends and the links it
+/// follows, see #reversed. operations walking the whole list from its head, like ll_insert_many_at or
+/// ll_snapshot, put the nodes back in order first, in O(len).
+/// @returns LL_OK
+///     || LL_ERROR_NULL_LINKED_LIST_POINTER
+ll_Error ll_reverse(ll_LinkedList *self) {
+    if (self == NULL) return LL_ERROR_NULL_LINKED_LIST_POINTER;
+    self->reversed = !self->reversed;
+    return LL_OK;
+}
+
+
+/// moves the first #k elements to the back in order, or the last -#k elements to the front if #k is negative.
+/// only the links at the ends and at the split are changed, the split being found from the closer end.
+/// @returns LL_OK
+///     || LL_ERROR_NULL_LINKED_LIST_POINTER
+ll_Error ll_rotate(ll_LinkedList *self, i64 k) {
+    if (self == NULL) return LL_ERROR_NULL_LINKED_LIST_POINTER;
+    if (self->len < 2) return LL_OK;
+    size_t shift = (size_t)(k < 0 ? -(u64)k : (u64)k) % self->len;
+    if (shift == 0) return LL_OK;
+    // unsharing may clear #reversed, so it goes first
+    EXPECT_PASS(ensure_unshared(self));
+    // a right rotation, or a left one of a reversed list, moves the head node the other way
+    if ((k < 0) != self->reversed) shift = self->len - shift;
+
+    struct ll_LinkedListNode *head = node_at(self, shift);
+    self->tail->next = self->head;
+    self->head->prev = self->tail;
+    self->tail = head->prev;
+    self->tail->next = NULL;
+    head->prev = NULL;
+    self->head = head;
+    return LL_OK;
+}
+
+
+// ----------------------------------------------------------------------------------------------------------
+// Serialization---------------------------------------------------------------------------------------------
+// ----------------------------------------------------------------------------------------------------------
+/* ll_save format, in host byte order:
+ *  - ll_SaveHeader: magic, version, data_size, len and a checksum of the payload stream
+ *  - len payloads of data_size bytes each, from head to tail, with no framing between them
+ */
+
+#define LL_SAVE_MAGIC 0x54534c4cu // "LLST"
+#define LL_SAVE_VERSION 1u
+#define LL_IO_BUFFER_SIZE (1 << 16)
+
+typedef struct {
+    u32 magic;
+    u32 version;
+    u32 data_size;
+    u32 reserved;
+    u64 len;
+    u64 checksum;
+}ll_SaveHeader;
+
+/// fletcher-style checksum over a byte stream. it can be continued across calls through #state.
+static inline void checksum_update(u64 state[2], const u8 *bytes, size_t n) {
+    u64 a = state[0], b = state[1];
+    for (size_t i = 0; i < n; i++) {
+        a += bytes[i];
+        b += a;
+    }
+    state[0] = a;
+    state[1] = b;
+}
+
+static inline u64 checksum_final(const u64 state[2]) {
+    return state[1] << 32 ^ state[0];
+}
+
+/// blocks until #fd is ready for #events. this lets the helpers below finish a transfer on non-blocking
+/// descriptors.
+/// @returns LL_OK || LL_ERROR_IO_FAILURE
+static ll_Error wait_fd(int fd, short events) {
+    struct pollfd pfd = {.fd = fd, .events = events};
+    while (poll(&pfd, 1, -1) < 0) {
+        if (errno != EINTR) return LL_ERROR_IO_FAILURE;
+    }
+    return LL_OK;
+}
+
+static inline bool would_block(void) {
+    return errno == EAGAIN || errno == EWOULDBLOCK;
+}
+
+/// writes all #n bytes, retrying on partial writes and interrupts.
+/// @returns LL_OK || LL_ERROR_IO_FAILURE
+static ll_Error write_all(int fd, const void *buf, size_t n) {
+    const u8 *cur = buf;
+    while (n > 0) {
+        ssize_t written = write(fd, cur, n);
+        if (written < 0 && errno == EINTR) continue;
+        if (written < 0 && would_block()) {
+            EXPECT_PASS(wait_fd(fd, POLLOUT));
+            continue;
+        }
+        if (written <= 0) return LL_ERROR_IO_FAILURE;
+        cur += written;
+        n -= written;
+    }
+    return LL_OK;
+}
+
+/// reads until #n bytes are read or the end of the file is reached.
+/// @param out_read number of bytes read, which is less than #n only at the end of the file.
+/// @returns LL_OK || LL_ERROR_IO_FAILURE
+static ll_Error read_full(int fd, void *buf, size_t n, size_t *out_read) {
+    u8 *cur = buf;
+    size_t total = 0;
+    while (total < n) {
+        ssize_t got = read(fd, cur + total, n - total);
+        if (got < 0 && errno == EINTR) continue;
+        if (got < 0 && would_block()) {
+            EXPECT_PASS(wait_fd(fd, POLLIN));
+            continue;
+        }
+        if (got < 0) return LL_ERROR_IO_FAILURE;
+        if (got == 0) break;
+        total += got;
+    }
+    *out_read = total;
+    return LL_OK;
+}
+
+/// writes the list to #fd as a header followed by every payload from head to tail.
+/// payloads are gathered into a large buffer so that the number of writes doesn't depend on the node count.
+/// @returns LL_OK
+///     || LL_ERROR_NULL_LINKED_LIST_POINTER
+///     || LL_ERROR_MALLOC_FAILURE
+///     || LL_ERROR_IO_FAILURE
+ll_Error ll_save(const ll_LinkedList *self, int fd) {
+    if (self == NULL) return LL_ERROR_NULL_LINKED_LIST_POINTER;
+
+    // the checksum is stored in the header, so it takes a pass over the payloads before anything is written
+    u64 state[2] = {0, 0};
+    for (struct ll_LinkedListNode *n = first_node(self); n != NULL; n = next_node(self, n)) {
+        checksum_update(state, n->data, self->data_size);
+    }
+
+    ll_SaveHeader header = {
+        .magic = LL_SAVE_MAGIC,
+        .version = LL_SAVE_VERSION,
+        .data_size = self->data_size,
+        .reserved = 0,
+        .len = self->len,
+        .checksum = checksum_final(state),
+    };
+
+    u8 *buf = malloc(LL_IO_BUFFER_SIZE);
+    if (buf == NULL) return LL_ERROR_MALLOC_FAILURE;
+    memcpy(buf, &header, sizeof(header));
+    size_t used = sizeof(header);
+
+    ll_Error status = LL_OK;
+    for (struct ll_LinkedListNode *n = first_node(self); n != NULL && status == LL_OK; n = next_node(self, n)) {
+        const u8 *payload = n->data;
+        size_t remaining = self->data_size;
+        while (remaining > 0) {
+            size_t chunk = LL_IO_BUFFER_SIZE - used;
+            if (chunk > remaining) chunk = remaining;
+            memcpy(buf + used, payload, chunk);
+            used += chunk;
+            payload += chunk;
+            remaining -= chunk;
+
+            if (used == LL_IO_BUFFER_SIZE) {
+                status = write_all(fd, buf, used);
+                if (status != LL_OK) break;
+                used = 0;
+            }
+        }
+    }
+    if (status == LL_OK && used > 0) status = write_all(fd, buf, used);
+    STATS_ADD(self, bytes_copied, (u64)self->len * self->data_size);
+
+    free(buf);
+    return status;
+}
+
+/// reads a list written by ll_save from #fd. all nodes are allocated in a single run and the payloads are read
+/// in large chunks.
+/// @param out_list receives the new list, which must be released with ll_free. it's untouched on failure.
+/// @returns LL_OK
+///     || LL_ERROR_NULL_LINKED_LIST_POINTER
+///     || LL_ERROR_MALLOC_FAILURE
+///     || LL_ERROR_IO_FAILURE
+///     || LL_ERROR_INVALID_FORMAT if the header is not recognized or the stream is truncated
+///     || LL_ERROR_CHECKSUM_MISMATCH
+ll_Error ll_load(int fd, ll_LinkedList **out_list) {
+    if (out_list == NULL) return LL_ERROR_NULL_LINKED_LIST_POINTER;
+
+    ll_SaveHeader header;
+    size_t got;
+    EXPECT_PASS(read_full(fd, &header, sizeof(header), &got));
+    if (got != sizeof(header)) return LL_ERROR_INVALID_FORMAT;
+    if (header.magic != LL_SAVE_MAGIC || header.version != LL_SAVE_VERSION) return LL_ERROR_INVALID_FORMAT;
+    // the nodes must be addressable at the stride the pool will use, rounded up to pointers as ll_pool_init does
+    u64 node_stride = (u64)sizeof(struct ll_LinkedListNode) + header.data_size;
+    node_stride = (node_stride + sizeof(void*) - 1) & ~(u64)(sizeof(void*) - 1);
+    if (header.len > SIZE_MAX / node_stride) return LL_ERROR_INVALID_FORMAT;
+
+    ll_LinkedList *list = ll_new(header.data_size);
+    if (list == NULL) return LL_ERROR_MALLOC_FAILURE;
+    if (header.len == 0) {
+        if (header.checksum != 0) {
+            ll_free(&list);
+            return LL_ERROR_CHECKSUM_MISMATCH;
+        }
+        *out_list = list;
+        return LL_OK;
+    }
+
+    u8 *nodes = ll_pool_alloc_run(&list->pool, header.len);
+    u8 *buf = malloc(LL_IO_BUFFER_SIZE);
+    if (nodes == NULL || buf == NULL) {
+        free(buf);
+        ll_free(&list);
+        return LL_ERROR_MALLOC_FAILURE;
+    }
+
+    link_run(list, nodes, header.len);
+    const size_t stride = list->pool.node_size;
+
+    // scatter the payload stream into the nodes
+    ll_Error status = LL_OK;
+    u64 state[2] = {0, 0};
+    size_t total = (size_t)header.len * header.data_size;
+    size_t node_index = 0, node_offset = 0;
+    while (total > 0) {
+        size_t want = total < LL_IO_BUFFER_SIZE ? total : LL_IO_BUFFER_SIZE;
+        status = read_full(fd, buf, want, &got);
+        if (status != LL_OK) break;
+        if (got != want) {
+            status = LL_ERROR_INVALID_FORMAT;
+            break;
+        }
+        checksum_update(state, buf, got);
+        total -= got;
+
+        const u8 *cur = buf;
+        while (got > 0) {
+            struct ll_LinkedListNode *node = (struct ll_LinkedListNode*)(nodes + node_index * stride);
+            size_t chunk = header.data_size - node_offset;
+            if (chunk > got) chunk = got;
+            memcpy(node->data + node_offset, cur, chunk);
+            cur += chunk;
+            got -= chunk;
+            node_offset += chunk;
+            if (node_offset == header.data_size) {
+                node_offset = 0;
+                node_index++;
+            }
+        }
+    }
+    free(buf);
+
+    STATS_ADD(list, bytes_copied, (u64)header.len * header.data_size);
+    if (status == LL_OK && checksum_final(state) != header.checksum) status = LL_ERROR_CHECKSUM_MISMATCH;
+    if (status != LL_OK) {
+        ll_free(&list);
+        return status;
+    }
+
+    *out_list = list;
+    return LL_OK;
+}
+
+
+// ----------------------------------------------------------------------------------------------------------
+// Record Streaming------------------------------------------------------------------------------------------
+// ----------------------------------------------------------------------------------------------------------
+/* records are raw data_size-byte payloads back to back. each readv/writev moves up to LL_IO_BATCH_RECORDS
+ * records straight between the descriptor and the node payloads, so there's no intermediate buffer.
+ */
+
+#define LL_IO_BATCH_RECORDS 256
+
+/// links #count detached nodes to the tail in order.
+static void append_nodes(ll_LinkedList *self, struct ll_LinkedListNode **nodes, u32 count) {
+    for (u32 i = 0; i < count; i++) {
+        struct ll_LinkedListNode *node = nodes[i];
+        node->next = NULL;
+        node->prev = self->tail;
+        if (self->tail == NULL) self->head = node;
+        else self->tail->next = node;
+        self->tail = node;
+    }
+    self->len += count;
+    STATS_TRACK_LEN(self);
+}
+
+/// reads up to #max_records records from #fd and pushes them to the tail.
+/// it stops early at the end of the file, or when a non-blocking #fd has no data ready. a record that was
+/// partially read is always completed, waiting for the descriptor if needed, so records are never split
+/// between calls.
+/// @param out_records number of records pushed, also on failure. ignored if NULL.
+/// @returns LL_OK
+///     || LL_ERROR_NULL_LINKED_LIST_POINTER
+///     || LL_ERROR_INSUFFICIENT_SIZE if the list has a data_size of 0
+///     || LL_ERROR_MALLOC_FAILURE
+///     || LL_ERROR_IO_FAILURE
+///     || LL_ERROR_INVALID_FORMAT if the file ends in the middle of a record
+ll_Error ll_ingest_fd(ll_LinkedList *self, int fd, u32 max_records, u32 *out_records) {
+    if (self == NULL) return LL_ERROR_NULL_LINKED_LIST_POINTER;
+    if (self->data_size == 0) return LL_ERROR_INSUFFICIENT_SIZE;
+    EXPECT_PASS(ensure_unshared(self));
+    EXPECT_PASS(ensure_forward(self));
+
+    struct ll_LinkedListNode *batch[LL_IO_BATCH_RECORDS];
+    struct iovec iov[LL_IO_BATCH_RECORDS];
+    ll_Error status = LL_OK;
+    u32 total = 0;
+    bool done = false;
+
+    while (!done && total < max_records) {
+        u32 want = max_records - total;
+        if (want > LL_IO_BATCH_RECORDS) want = LL_IO_BATCH_RECORDS;
+
+        u32 count = 0;
+        for (; count < want; count++) {
+            batch[count] = node_alloc(self);
+            if (batch[count] == NULL) break;
+            iov[count].iov_base = batch[count]->data;
+            iov[count].iov_len = self->data_size;
+        }
+        if (count == 0) {
+            status = LL_ERROR_MALLOC_FAILURE;
+            break;
+        }
+
+        ssize_t got = readv(fd, iov, count);
+        u32 complete = 0;
+        if (got < 0 && errno == EINTR) {
+            // nothing was read, the next iteration retries
+        } else if (got < 0 && would_block()) {
+            done = true;
+        } else if (got < 0) {
+            status = LL_ERROR_IO_FAILURE;
+        } else if (got == 0) {
+            done = true;
+        } else {
+            complete = got / self->data_size;
+            size_t partial = got % self->data_size;
+            if (partial != 0) {
+                size_t rest;
+                u8 *dst = batch[complete]->data + partial;
+                status = read_full(fd, dst, self->data_size - partial, &rest);
+                if (status == LL_OK && rest != self->data_size - partial) status = LL_ERROR_INVALID_FORMAT;
+                if (status == LL_OK) complete++;
+            }
+        }
+
+        append_nodes(self, batch, complete);
+        for (u32 i = complete; i < count; i++) node_free(self, batch[i]);
+        total += complete;
+        if (status != LL_OK) break;
+    }
 
-    free(node);
-    return LL_OK;
+    if (out_records != NULL) *out_records = total;
+    return status;
 }
 
-
-/// determines the shortest path from head to index or tail to index and iterates through it
-/// the node at the index is written to out_node
+/// writes up to #max_records records from the head of the list to #fd and pops them.
+/// it stops early when the list is empty, or when a non-blocking #fd can't take more data. a record that was
+/// partially written is always completed, waiting for the descriptor if needed.
+/// @param out_records number of records written and popped, also on failure. ignored if NULL.
 /// @returns LL_OK
 ///     || LL_ERROR_NULL_LINKED_LIST_POINTER
-///     || LL_ERROR_NULL_NODE_POINTER
-///     || LL_ERROR_EMPTY_LINKED_LIST
-///     || LL_ERROR_INDEX_OUT_OF_BOUNDS
+///     || LL_ERROR_INSUFFICIENT_SIZE if the list has a data_size of 0
+///     || LL_ERROR_IO_FAILURE
 ///     || LL_ERROR_INTERNAL
-ll_Error iterate_to(const ll_LinkedList *self, struct ll_LinkedListNode **out_node, int index) {
+ll_Error ll_drain_fd(ll_LinkedList *self, int fd, u32 max_records, u32 *out_records) {
     if (self == NULL) return LL_ERROR_NULL_LINKED_LIST_POINTER;
-    if (out_node == NULL) return LL_ERROR_NULL_NODE_POINTER;
-    if (ll_is_empty(self)) return LL_ERROR_EMPTY_LINKED_LIST;
-    if (!EXPECT_S(is_index_within_get_bounds, self, bool, index)) return LL_ERROR_INDEX_OUT_OF_BOUNDS;
-    if (!EXPECT_S(has_valid_head_tail_state, self, bool)) ERROR_RETURN(LL_ERROR_INTERNAL);
+    if (self->data_size == 0) return LL_ERROR_INSUFFICIENT_SIZE;
+    EXPECT_PASS(ensure_unshared(self));
+    EXPECT_PASS(ensure_forward(self));
+
+    struct iovec iov[LL_IO_BATCH_RECORDS];
+    ll_Error status = LL_OK;
+    u32 total = 0;
+
+    while (total < max_records && self->len > 0) {
+        u32 want = max_records - total;
+        if (want > LL_IO_BATCH_RECORDS) want = LL_IO_BATCH_RECORDS;
+        if (want > self->len) want = self->len;
+
+        struct ll_LinkedListNode *node = self->head;
+        for (u32 i = 0; i < want; i++, node = node->next) {
+            if (node == NULL) ERROR_RETURN(LL_ERROR_INTERNAL);
+            iov[i].iov_base = node->data;
+            iov[i].iov_len = self->data_size;
+        }
 
-    // iterate to target node to retrieve
-    struct ll_LinkedListNode *target = NULL;
-    if ((int)self->len - index < index) {
-        // better iterate in reverse since the distance from tail is shorter
-        for (target=self->tail; target != NULL; target = target->prev) {
-            if (self->len - ++index == 0) break;
+        ssize_t put = writev(fd, iov, want);
+        if (put < 0 && errno == EINTR) continue;
+        if (put < 0 && would_block()) break;
+        if (put <= 0) {
+            status = LL_ERROR_IO_FAILURE;
+            break;
         }
-    } else {
-        // iterate from head
-        for (target=self->head; target != NULL; target = target->next) {
-            if (index-- == 0) break;
+
+        u32 complete = put / self->data_size;
+        size_t partial = put % self->data_size;
+        if (partial != 0) {
+            status = write_all(fd, (u8*)iov[complete].iov_base + partial, self->data_size - partial);
+            if (status == LL_OK) complete++;
         }
+
+        for (u32 i = 0; i < complete; i++) EXPECT_PASS(pop_head(self, NULL));
+        total += complete;
+        if (status != LL_OK) break;
     }
-    
-    if (target == NULL) ERROR_RETURN(LL_ERROR_INTERNAL);
-    *out_node = target;
-    return LL_OK;
+
+    if (out_records != NULL) *out_records = total;
+    return status;
 }
 
 
-/// traverses to the nth node (unless it's tail or head) and left-inserts a node with the element content at
-/// the given index.
-/// @param index must be within the raneg [0..self->len()] where self->len() indicates a tail insert.
+// ----------------------------------------------------------------------------------------------------------
+// Statistics------------------------------------------------------------------------------------------------
+// ----------------------------------------------------------------------------------------------------------
+
+/// copies the counters of the list. operations that delegate to others (like ll_insert at the tail) count
+/// as both.
 /// @returns LL_OK
 ///     || LL_ERROR_NULL_LINKED_LIST_POINTER
 ///     || LL_ERROR_NULL_ELEMENT_POINTER
-///     || LL_ERROR_INDEX_OUT_OF_BOUNDS
-///     || LL_ERROR_MALLOC_FAILURE
-///     || LL_ERROR_INTERNAL
-ll_Error ll_insert(ll_LinkedList *self, int index, void *elem) {
+///     || LL_ERROR_UNSUPPORTED if compiled without LL_STATS
+ll_Error ll_stats_get(const ll_LinkedList *self, ll_Stats *out_stats) {
     if (self == NULL) return LL_ERROR_NULL_LINKED_LIST_POINTER;
-    if (elem == NULL) return LL_ERROR_NULL_ELEMENT_POINTER;
-    if (!EXPECT_S(is_index_within_insert_bounds, self, bool, index)) return LL_ERROR_INDEX_OUT_OF_BOUNDS;
-    
-    if (self->len == 0 || index == (int)self->len) {
-        // one element, or at the end. Both of those insertions are handled with a push to tail
-        EXPECT_PASS(ll_push(self, elem));
-    }
-    else if (index == 0) {
-        // insertion in the front, but this is not an empty linkedlist, that's a front push
-        EXPECT_PASS(ll_push_front(self, elem));
-    }
-    else {
-        // traverse to node to insert at
-        struct ll_LinkedListNode *target_node = NULL; 
-        ll_Error status = iterate_to(self, &target_node, index);
-        if (status != LL_OK) ERROR_RETURN(LL_ERROR_INTERNAL);
-        if (target_node == NULL) ERROR_RETURN(LL_ERROR_INTERNAL);
+    if (out_stats == NULL) return LL_ERROR_NULL_ELEMENT_POINTER;
+#ifdef LL_STATS
+    *out_stats = self->stats;
+    return LL_OK;
+#else
+    memset(out_stats, 0, sizeof(*out_stats));
+    return LL_ERROR_UNSUPPORTED;
+#endif
+}
 
-        // insert new node to the left of #target_node at index
-        struct ll_LinkedListNode *node = malloc(sizeof(struct ll_LinkedListNode));
-        if (node == NULL) ERROR_RETURN(LL_ERROR_MALLOC_FAILURE);
-        node->next = target_node;
-        node->prev = target_node->prev;
-        memcpy(node->data, elem, self->data_size);
+/// zeroes the counters. the high-water mark restarts from the current length.
+/// @returns LL_OK
+///     || LL_ERROR_NULL_LINKED_LIST_POINTER
+///     || LL_ERROR_UNSUPPORTED if compiled without LL_STATS
+ll_Error ll_stats_reset(ll_LinkedList *self) {
+    if (self == NULL) return LL_ERROR_NULL_LINKED_LIST_POINTER;
+#ifdef LL_STATS
+    memset(&self->stats, 0, sizeof(self->stats));
+    self->stats.len_high_water = self->len;
+    return LL_OK;
+#else
+    return LL_ERROR_UNSUPPORTED;
+#endif
+}
 
-        target_node->prev = node;
-        self->len++;
-    }
 
+// ----------------------------------------------------------------------------------------------------------
+// Snapshots-------------------------------------------------------------------------------------------------
+// ----------------------------------------------------------------------------------------------------------
+
+/// moves the nodes of a small list out of its inline slab, which stays empty in the new pool.
+static ll_Error evict_inline(ll_LinkedList *self) {
+    ll_NodePool pool;
+    struct ll_LinkedListNode *head, *tail;
+    pool_like(self, &pool);
+    EXPECT_PASS(copy_nodes(self, &pool, &head, &tail));
+    STATS_ADD(self, node_frees, self->len);
+    move_inline(&self->pool, &pool);
+    ll_pool_destroy(&self->pool);
+    self->pool = pool;
+    self->head = head;
+    self->tail = tail;
+    self->reversed = false;
     return LL_OK;
 }
 
 
-/// traverses to the nth node (unless it's a tail or head) and sets the data of that node to the content of #elem.
-/// @param index must be within the range [0..self->len())
-/// @returns LL_OK
-///     || LL_ERROR_NULL_LINKED_LIST_POINTER
-///     || LL_ERROR_NULL_ELEMENT_POINTER
-///     || LL_ERROR_INDEX_OUT_OF_BOUNDS
-///     || LL_ERROR_INTERNAL
-ll_Error ll_set(ll_LinkedList *self, int index, void *elem) {
-    if (self == NULL) return LL_ERROR_NULL_LINKED_LIST_POINTER;
-    if (elem == NULL) return LL_ERROR_NULL_ELEMENT_POINTER;
-    if (!EXPECT_S(is_index_within_get_bounds, self, bool, index)) return LL_ERROR_INDEX_OUT_OF_BOUNDS;
-    if (!EXPECT_S(has_valid_head_tail_state, self, bool)) ERROR_RETURN(LL_ERROR_INTERNAL);
+/// returns an immutable view of the list as it is now, in O(1), or NULL on failure.
+/// the list copies its nodes once, before the first mutation that follows, so the snapshot never changes.
+/// snapshots taken with no mutation in between are the same snapshot with one more reference.
+/// a list made with ll_new_small first moves its nodes out of the inline storage, in O(len).
+/// ll_snapshot must be called from the thread mutating the list. the snapshot can then be read and released from
+/// any thread, and it outlives the list if needed.
+ll_Snapshot* ll_snapshot(ll_LinkedList *self) {
+    if (self == NULL) return NULL;
+    // the snapshot reads from head to tail, and an existing one may predate the ll_reverse
+    if (ensure_forward(self) != LL_OK) return NULL;
+    if (self->snapshot != NULL) {
+        atomic_fetch_add_explicit(&self->snapshot->refs, 1, memory_order_relaxed);
+        return self->snapshot;
+    }
 
-    // iterate to target node to retrieve (or error return)
-    struct ll_LinkedListNode *target = EXPECT_S(iterate_to, self, struct ll_LinkedListNode*, index);
+    if (self->pool.inline_slab != NULL && self->len > 0 && evict_inline(self) != LL_OK) return NULL;
+    ll_Snapshot *out = self->pool.alloc->alloc(self->pool.alloc_ctx, sizeof(ll_Snapshot));
+    if (out == NULL) return NULL;
+    out->head = self->head;
+    out->tail = self->tail;
+    out->data_size = self->data_size;
+    out->len = self->len;
+    atomic_init(&out->refs, 2);
+    memset(&out->pool, 0, sizeof(out->pool));
+    self->snapshot = out;
+    return out;
+}
 
-    // retrieve target node data
-    if (target == NULL) ERROR_RETURN(LL_ERROR_INTERNAL);
-    memcpy(target->data, elem, self->data_size);
-    
+
+/// drops a reference returned by ll_snapshot and sets the pointer to NULL. the last one frees the snapshot's
+/// nodes once its list stopped sharing them.
+/// @returns LL_OK
+///     || LL_ERROR_NULL_LINKED_LIST_POINTER (can happen with double release)
+ll_Error ll_snapshot_release(ll_Snapshot **self) {
+    if (self == NULL || *self == NULL) return LL_ERROR_NULL_LINKED_LIST_POINTER;
+    snapshot_unref(*self);
+    *self = NULL;
     return LL_OK;
 }
 
-/// retrieves the data in a node at an index without removing that node.
-/// it's preferable to iterate rather than use this function as it's O(n)
-/// @param out_elem node data to be gotten.
+
+/// copies the element at #index of the snapshot to #out_elem.
 /// @returns LL_OK
 ///     || LL_ERROR_NULL_LINKED_LIST_POINTER
 ///     || LL_ERROR_NULL_ELEMENT_POINTER
-///     || LL_ERROR_EMPTY_LINKED_LIST,
 ///     || LL_ERROR_INDEX_OUT_OF_BOUNDS
-///     || LL_ERROR_INTERNAL
-ll_Error ll_get(const ll_LinkedList *self, void *out_elem, int index) {
+ll_Error ll_snapshot_get(const ll_Snapshot *self, void *out_elem, size_t index) {
     if (self == NULL) return LL_ERROR_NULL_LINKED_LIST_POINTER;
     if (out_elem == NULL) return LL_ERROR_NULL_ELEMENT_POINTER;
-    if (ll_is_empty(self)) return LL_ERROR_EMPTY_LINKED_LIST;
-    if (!EXPECT_S(is_index_within_get_bounds, self, bool, index)) return LL_ERROR_INDEX_OUT_OF_BOUNDS;
-
-    // iterate to target node to retrieve (or error return)
-    struct ll_LinkedListNode *target = EXPECT_S(iterate_to, self, struct ll_LinkedListNode*, index);
+    if (index >= self->len) return LL_ERROR_INDEX_OUT_OF_BOUNDS;
 
-    // retrieve target node data
-    if (target == NULL) ERROR_RETURN(LL_ERROR_INTERNAL);
-    memcpy(out_elem, target->data, self->data_size);
-    
+    const struct ll_LinkedListNode *node;
+    if (self->len - 1 - index < index) {
+        node = self->tail;
+        for (size_t i = self->len - 1; i > index; i--) node = node->prev;
+    } else {
+        node = self->head;
+        for (size_t i = 0; i < index; i++) node = node->next;
+    }
+    memcpy(out_elem, node->data, self->data_size);
     return LL_OK;
 }
 
 
-/// @param out_elem data of removed element to be written. if NULL, it's discarded.
-/// @param index must be [0..self->len) 
+// ----------------------------------------------------------------------------------------------------------
+// Memory----------------------------------------------------------------------------------------------------
+// ----------------------------------------------------------------------------------------------------------
+
+/// reports where the list's memory goes. nodes shared with a snapshot are counted as the list's.
 /// @returns LL_OK
 ///     || LL_ERROR_NULL_LINKED_LIST_POINTER
-///     || LL_ERROR_EMPTY_LINKED_LIST
-///     || LL_ERROR_INDEX_OUT_OF_BOUNDS
-///     || LL_ERROR_INTERNAL
-ll_Error ll_remove(ll_LinkedList *self, void *out_elem, int index) {
+///     || LL_ERROR_NULL_ELEMENT_POINTER
+ll_Error ll_memory_usage(const ll_LinkedList *self, ll_MemoryUsage *out_usage) {
     if (self == NULL) return LL_ERROR_NULL_LINKED_LIST_POINTER;
-    if (ll_is_empty(self)) return LL_ERROR_EMPTY_LINKED_LIST;
-    if (!EXPECT_S(is_index_within_get_bounds, self, bool, index)) return LL_ERROR_INDEX_OUT_OF_BOUNDS;
+    if (out_usage == NULL) return LL_ERROR_NULL_ELEMENT_POINTER;
 
-    if (self->len == 1 || index == (int)self->len-1) {
-        EXPECT_PASS(ll_pop(self, out_elem));
+    size_t slabs = 0, capacity = 0;
+    for (const struct ll_PoolSlab *slab = self->pool.slabs; slab; slab = slab->next) {
+        slabs++;
+        capacity += slab->capacity;
     }
-    else if (index == 0) {
-        EXPECT_PASS(ll_pop_front(self, out_elem));
-    }
-    else {
-        struct ll_LinkedListNode *target = EXPECT_S(iterate_to, self, struct ll_LinkedListNode*, index);
+    out_usage->payload_bytes = self->len * self->data_size;
+    out_usage->link_bytes = self->len * (self->pool.node_size - self->data_size);
+    out_usage->header_bytes = sizeof(ll_LinkedList) + slabs * sizeof(struct ll_PoolSlab);
+    out_usage->slack_bytes = (capacity - self->len) * self->pool.node_size;
+    out_usage->total_bytes = sizeof(ll_LinkedList) + ll_pool_footprint(&self->pool);
+    return LL_OK;
+}
 
-        // link the target's prev with next as it must be a middle node
-        if (target == NULL) ERROR_RETURN(LL_ERROR_INTERNAL);
-        if (target->prev == NULL || target->next == NULL) ERROR_RETURN(LL_ERROR_INTERNAL);
-        target->prev->next = target->next;
-        target->next->prev = target->prev;
 
-        if (out_elem != NULL) memcpy(out_elem, target->data, self->data_size);
-        free(target);
-        self->len--;
+/// destroys #pool, returning the bytes of its pages given back to the OS if its allocator can't free.
+static size_t release_pool(ll_NodePool *pool) {
+    size_t discarded = pool->alloc->free == NULL ? ll_pool_discard_pages(pool) : 0;
+    ll_pool_destroy(pool);
+    return discarded;
+}
+
+
+/// moves the nodes into a single dense run and releases the old slabs, so that the memory left behind by a
+/// drained list goes back to the allocator. slabs of allocators that can't free (like ll_arena_allocator) have
+/// their pages given back to the OS instead. a list made with ll_new_small moves its nodes back inline if they
+/// fit. node pointers from iterate_to are invalidated.
+/// if the nodes are shared with a snapshot they are copied as a mutation would, and nothing is reclaimed.
+/// @param out_reclaimed bytes the list no longer holds, ignored if NULL.
+/// @returns LL_OK
+///     || LL_ERROR_NULL_LINKED_LIST_POINTER
+///     || LL_ERROR_MALLOC_FAILURE
+ll_Error ll_shrink(ll_LinkedList *self, size_t *out_reclaimed) {
+    if (self == NULL) return LL_ERROR_NULL_LINKED_LIST_POINTER;
+    if (out_reclaimed != NULL) *out_reclaimed = 0;
+    if (self->snapshot != NULL) return unshare(self);
+
+    size_t before = ll_pool_footprint(&self->pool);
+    size_t discarded = 0;
+    ll_NodePool pool;
+    struct ll_LinkedListNode *head, *tail;
+    pool_like(self, &pool);
+    EXPECT_PASS(copy_nodes(self, &pool, &head, &tail));
+    STATS_ADD(self, node_frees, self->len);
+    struct ll_PoolSlab *inline_slab = ll_pool_detach_inline(&self->pool);
+    discarded += release_pool(&self->pool);
+    self->pool = pool;
+    self->head = head;
+    self->tail = tail;
+    self->reversed = false;
+
+    if (inline_slab != NULL && self->len <= inline_slab->capacity) {
+        // the nodes may have been inline already, so they go back in from the run with a second copy
+        pool_like(self, &pool);
+        ll_pool_add_inline(&pool, inline_slab, inline_slab->capacity);
+        EXPECT_PASS(copy_nodes(self, &pool, &head, &tail));
+        STATS_ADD(self, node_frees, self->len);
+        discarded += release_pool(&self->pool);
+        self->pool = pool;
+        self->head = head;
+        self->tail = tail;
+        self->reversed = false;
+    } else if (inline_slab != NULL) {
+        ll_pool_add_inline(&self->pool, inline_slab, inline_slab->capacity);
     }
 
+    // with an allocator that can't free, the runs come from it too, so only the discarded pages count
+    size_t reclaimed = self->pool.alloc->free != NULL ? before - ll_pool_footprint(&self->pool) : discarded;
+    if (out_reclaimed != NULL) *out_reclaimed = reclaimed;
     return LL_OK;
 }
 
 
+/// releases everything allocated through #alloc_ctx at once, which invalidates every list created with it.
+/// @returns LL_OK
+///     || LL_ERROR_NULL_ELEMENT_POINTER
+///     || LL_ERROR_UNSUPPORTED if #alloc has no bulk_free callback
+ll_Error ll_allocator_bulk_free(const ll_Allocator *alloc, void *alloc_ctx) {
+    if (alloc == NULL) return LL_ERROR_NULL_ELEMENT_POINTER;
+    if (alloc->bulk_free == NULL) return LL_ERROR_UNSUPPORTED;
+    alloc->bulk_free(alloc_ctx);
+    return LL_OK;
+}
+
 
 ll_Error ll_buf_init(ll_BufferLinkedList *self, void *buffer, int data_size);
 ll_Error ll_buf_push(ll_BufferLinkedList *self, void *elem);
@@ -399,7 +1913,7 @@ ll_Error ll_buf_remove(ll_BufferLinkedList *self, int index);
 
 
 
-#ifndef CUNIT_TESTS
+#if !defined(CUNIT_TESTS) && !defined(LL_BENCH) && !defined(LL_PROFILE)
 int main(void) {
     ll_LinkedList *list = ll_new(sizeof(int));
     int x = 12;
@@ -429,6 +1943,13 @@ int main(void) {
 #include "CUnit/CUnit.h"
 #include "CUnit/Basic.h"
 #include "cunit_utils/lib.h"
+#include <fcntl.h>
+#include "ll_mmap.h"
+#include "ll_var.h"
+#include "ll_xor.h"
+#include "ll_intrusive.h"
+#include "ll_node_arena.h"
+#include "ll_error.h"
 
 ll_LinkedList* assert_new(u32 data_size) {
     ll_LinkedList *ll = ll_new(data_size);
@@ -762,6 +2283,1097 @@ void test_display(void) {
     ll_free(&ll);
 }
 
+void test_save_load(void) {
+    ll_LinkedList *ll = assert_new(/*data_size*/ 4);
+    for (u32 i = 0; i < 20000; i++) ll_push(ll, &i);
+    CUU_ASSERT(assert_insert_u32(ll, 3, 0xABCD));
+
+    FILE *file = tmpfile();
+    if (!CUU_ASSERT_PTR_NOT_NULL(file)) return;
+    int fd = fileno(file);
+    CUU_ASSERT_EQ_U32(ll_save(ll, fd), LL_OK);
+
+    // round trip
+    CUU_ASSERT(lseek(fd, 0, SEEK_SET) == 0);
+    ll_LinkedList *loaded = NULL;
+    CUU_ASSERT_EQ_U32(ll_load(fd, &loaded), LL_OK);
+    if (!CUU_ASSERT_PTR_NOT_NULL(loaded)) return;
+    CUU_ASSERT_EQ_U32(loaded->data_size, 4);
+    CUU_ASSERT_EQ_U32(loaded->len, ll->len);
+    struct ll_LinkedListNode *a = ll->head, *b = loaded->head;
+    for (; a != NULL && b != NULL; a = a->next, b = b->next) {
+        if (!CUU_ASSERT_EQ_U32(*(u32*)b->data, *(u32*)a->data)) break;
+    }
+    CUU_ASSERT_PTR_NULL(b);
+    CUU_ASSERT(assert_pop_u32(loaded, 19999));
+    CUU_ASSERT(assert_push_u32(loaded, 7));
+    CUU_ASSERT(assert_remove_u32(loaded, 3, 0xABCD));
+    ll_free(&loaded);
+
+    // a flipped payload byte is caught by the checksum
+    u8 byte;
+    CUU_ASSERT(pread(fd, &byte, 1, 100) == 1);
+    byte ^= 0xFF;
+    CUU_ASSERT(pwrite(fd, &byte, 1, 100) == 1);
+    CUU_ASSERT(lseek(fd, 0, SEEK_SET) == 0);
+    CUU_ASSERT_EQ_U32(ll_load(fd, &loaded), LL_ERROR_CHECKSUM_MISMATCH);
+    CUU_ASSERT_PTR_NULL(loaded);
+
+    // truncated stream
+    CUU_ASSERT(ftruncate(fd, 1000) == 0);
+    CUU_ASSERT(lseek(fd, 0, SEEK_SET) == 0);
+    CUU_ASSERT_EQ_U32(ll_load(fd, &loaded), LL_ERROR_INVALID_FORMAT);
+
+    // not a list
+    CUU_ASSERT(ftruncate(fd, 0) == 0);
+    CUU_ASSERT(pwrite(fd, "definitely not a saved list header", 34, 0) == 34);
+    CUU_ASSERT(lseek(fd, 0, SEEK_SET) == 0);
+    CUU_ASSERT_EQ_U32(ll_load(fd, &loaded), LL_ERROR_INVALID_FORMAT);
+    CUU_ASSERT_PTR_NULL(loaded);
+
+    // a header whose nodes couldn't be addressed
+    ll_SaveHeader huge = {.magic = LL_SAVE_MAGIC, .version = LL_SAVE_VERSION, .data_size = UINT32_MAX, .len = 1ull << 33};
+    CUU_ASSERT(ftruncate(fd, 0) == 0);
+    CUU_ASSERT(pwrite(fd, &huge, sizeof(huge), 0) == sizeof(huge));
+    CUU_ASSERT(lseek(fd, 0, SEEK_SET) == 0);
+    CUU_ASSERT_EQ_U32(ll_load(fd, &loaded), LL_ERROR_INVALID_FORMAT);
+    CUU_ASSERT_PTR_NULL(loaded);
+
+    // only addressable when the node stride isn't rounded up to pointers
+    huge.data_size = 1;
+    huge.len = SIZE_MAX / (sizeof(struct ll_LinkedListNode) + 1);
+    CUU_ASSERT(pwrite(fd, &huge, sizeof(huge), 0) == sizeof(huge));
+    CUU_ASSERT(lseek(fd, 0, SEEK_SET) == 0);
+    CUU_ASSERT_EQ_U32(ll_load(fd, &loaded), LL_ERROR_INVALID_FORMAT);
+    CUU_ASSERT_PTR_NULL(loaded);
+
+    // empty list
+    ll_LinkedList *empty = assert_new(/*data_size*/ 16);
+    CUU_ASSERT(ftruncate(fd, 0) == 0);
+    CUU_ASSERT(lseek(fd, 0, SEEK_SET) == 0);
+    CUU_ASSERT_EQ_U32(ll_save(empty, fd), LL_OK);
+    CUU_ASSERT(lseek(fd, 0, SEEK_SET) == 0);
+    CUU_ASSERT_EQ_U32(ll_load(fd, &loaded), LL_OK);
+    CUU_ASSERT(ll_is_empty(loaded));
+    CUU_ASSERT_EQ_U32(loaded->data_size, 16);
+
+    ll_free(&loaded);
+    ll_free(&empty);
+    ll_free(&ll);
+    fclose(file);
+}
+
+void test_mapped_list(void) {
+    char path[] = "/tmp/ll_map_test_XXXXXX";
+    char big_path[] = "/tmp/ll_map_test_XXXXXX";
+    int tmp_fd = mkstemp(path);
+    if (!CUU_ASSERT(tmp_fd >= 0)) return;
+    close(tmp_fd);
+
+    ll_MappedLinkedList map;
+    CUU_ASSERT_EQ_U32(ll_map_open(&map, path, /*data_size*/ 4), LL_OK);
+    size_t initial_size = map.size;
+    u32 out;
+    CUU_ASSERT_EQ_U32(ll_map_pop(&map, &out), LL_ERROR_EMPTY_LINKED_LIST);
+
+    // enough nodes to force the file to grow and remap
+    for (u32 i = 0; i < 10000; i++) CUU_ASSERT_EQ_U32(ll_map_push(&map, &i), LL_OK);
+    CUU_ASSERT(map.size > initial_size);
+    u32 front = 0xF00D;
+    CUU_ASSERT_EQ_U32(ll_map_push_front(&map, &front), LL_OK);
+    CUU_ASSERT_EQ_U32(ll_map_pop(&map, &out), LL_OK);
+    CUU_ASSERT_EQ_U32(out, 9999);
+    CUU_ASSERT_EQ_U32(ll_map_sync(&map), LL_OK);
+    CUU_ASSERT_EQ_U32(ll_map_close(&map), LL_OK);
+
+    // reopening maps the list as it was left
+    CUU_ASSERT_EQ_U32(ll_map_open(&map, path, /*data_size*/ 8), LL_ERROR_INVALID_FORMAT);
+    CUU_ASSERT_EQ_U32(ll_map_open(&map, path, /*data_size*/ 4), LL_OK);
+    CUU_ASSERT_EQ_U32(ll_map_len(&map), 10000);
+    CUU_ASSERT_EQ_U32(ll_map_get(&map, &out, 0), LL_OK);
+    CUU_ASSERT_EQ_U32(out, 0xF00D);
+    CUU_ASSERT_EQ_U32(ll_map_get(&map, &out, 1234), LL_OK);
+    CUU_ASSERT_EQ_U32(out, 1233);
+    CUU_ASSERT_EQ_U32(ll_map_get(&map, &out, 9999), LL_OK);
+    CUU_ASSERT_EQ_U32(out, 9998);
+    CUU_ASSERT_EQ_U32(ll_map_get(&map, &out, 10000), LL_ERROR_INDEX_OUT_OF_BOUNDS);
+
+    // freed nodes are reused before the file grows again
+    size_t size = map.size;
+    for (u32 i = 0; i < 5000; i++) ll_map_pop_front(&map, NULL);
+    for (u32 i = 0; i < 5000; i++) ll_map_push(&map, &i);
+    CUU_ASSERT_EQ_U32(map.size, size);
+    CUU_ASSERT_EQ_U32(ll_map_pop(&map, &out), LL_OK);
+    CUU_ASSERT_EQ_U32(out, 4999);
+    CUU_ASSERT_EQ_U32(ll_map_pop_front(&map, &out), LL_OK);
+    CUU_ASSERT_EQ_U32(out, 4999);
+
+    CUU_ASSERT_EQ_U32(ll_map_close(&map), LL_OK);
+    unlink(path);
+
+    // a node bigger than the whole mapping grows the file as many times as needed
+    u8 *big = calloc(1, 300000);
+    if (!CUU_ASSERT_PTR_NOT_NULL(big)) return;
+    int big_fd = mkstemp(big_path);
+    if (!CUU_ASSERT(big_fd >= 0)) {
+        free(big);
+        return;
+    }
+    close(big_fd);
+    CUU_ASSERT_EQ_U32(ll_map_open(&map, big_path, /*data_size*/ 300000), LL_OK);
+    big[299999] = 0xBB;
+    CUU_ASSERT_EQ_U32(ll_map_push(&map, big), LL_OK);
+    CUU_ASSERT(map.size >= 300000 + sizeof(struct ll_MappedLinkedListNode));
+    big[299999] = 0;
+    CUU_ASSERT_EQ_U32(ll_map_pop(&map, big), LL_OK);
+    CUU_ASSERT_EQ_U32(big[299999], 0xBB);
+    free(big);
+    CUU_ASSERT_EQ_U32(ll_map_close(&map), LL_OK);
+    unlink(big_path);
+    CUU_ASSERT_EQ_U32(ll_map_open(&map, big_path, /*data_size*/ UINT32_MAX), LL_ERROR_INSUFFICIENT_SIZE);
+}
+
+void test_ingest_drain_fd(void) {
+    ll_LinkedList *ll = assert_new(/*data_size*/ 4);
+    int fds[2];
+    if (!CUU_ASSERT(pipe(fds) == 0)) return;
+
+    u32 records[1000];
+    for (u32 i = 0; i < 1000; i++) records[i] = i * 3;
+    CUU_ASSERT(write(fds[1], records, sizeof(records)) == sizeof(records));
+
+    u32 count;
+    CUU_ASSERT_EQ_U32(ll_ingest_fd(ll, fds[0], 600, &count), LL_OK);
+    CUU_ASSERT_EQ_U32(count, 600);
+    CUU_ASSERT_EQ_U32(ll->len, 600);
+
+    // the rest is read until the end of the file
+    close(fds[1]);
+    CUU_ASSERT_EQ_U32(ll_ingest_fd(ll, fds[0], 5000, &count), LL_OK);
+    CUU_ASSERT_EQ_U32(count, 400);
+    CUU_ASSERT_EQ_U32(ll->len, 1000);
+    CUU_ASSERT(assert_get_u32(ll, 0, 0));
+    CUU_ASSERT(assert_get_u32(ll, 599, 599 * 3));
+    CUU_ASSERT(assert_get_u32(ll, 999, 999 * 3));
+    close(fds[0]);
+
+    // drain everything back out in order
+    if (!CUU_ASSERT(pipe(fds) == 0)) return;
+    CUU_ASSERT_EQ_U32(ll_drain_fd(ll, fds[1], 700, &count), LL_OK);
+    CUU_ASSERT_EQ_U32(count, 700);
+    CUU_ASSERT_EQ_U32(ll->len, 300);
+    CUU_ASSERT_EQ_U32(ll_drain_fd(ll, fds[1], 700, &count), LL_OK);
+    CUU_ASSERT_EQ_U32(count, 300);
+    CUU_ASSERT(ll_is_empty(ll));
+    u32 out[1000];
+    CUU_ASSERT(read(fds[0], out, sizeof(out)) == sizeof(out));
+    CUU_ASSERT(memcmp(out, records, sizeof(out)) == 0);
+
+    // non-blocking descriptors with no data ready return without records
+    fcntl(fds[0], F_SETFL, fcntl(fds[0], F_GETFL) | O_NONBLOCK);
+    CUU_ASSERT_EQ_U32(ll_ingest_fd(ll, fds[0], 10, &count), LL_OK);
+    CUU_ASSERT_EQ_U32(count, 0);
+    CUU_ASSERT(ll_is_empty(ll));
+
+    // a record cut off by the end of the file is dropped
+    CUU_ASSERT(write(fds[1], records, 6) == 6);
+    close(fds[1]);
+    CUU_ASSERT_EQ_U32(ll_ingest_fd(ll, fds[0], 10, &count), LL_ERROR_INVALID_FORMAT);
+    CUU_ASSERT_EQ_U32(count, 1);
+    CUU_ASSERT(assert_pop_u32(ll, 0));
+    CUU_ASSERT(assert_pop_empty_u32(ll));
+    close(fds[0]);
+
+    ll_free(&ll);
+}
+
+void test_var_list(void) {
+    ll_VarLinkedList *ll = ll_var_new();
+    if (!CUU_ASSERT_PTR_NOT_NULL(ll)) return;
+
+    const char *small = "hi";
+    u8 medium[300], large[5000];
+    memset(medium, 0x5A, sizeof(medium));
+    memset(large, 0xA5, sizeof(large));
+
+    CUU_ASSERT_EQ_U32(ll_var_push_bytes(ll, small, 2), LL_OK);
+    CUU_ASSERT_EQ_U32(ll_var_push_bytes(ll, medium, sizeof(medium)), LL_OK);
+    CUU_ASSERT_EQ_U32(ll_var_push_front_bytes(ll, large, sizeof(large)), LL_OK);
+    CUU_ASSERT_EQ_U32(ll_var_push_bytes(ll, NULL, 0), LL_OK);
+    CUU_ASSERT_EQ_U32(ll->len, 4);
+    CUU_ASSERT_EQ_U32(ll->head->size_class, LL_VAR_LARGE_CLASS);
+    CUU_ASSERT_EQ_U32(ll->head->next->size_class, 0);
+
+    // payloads are read in place
+    const void *ptr;
+    u32 len;
+    CUU_ASSERT_EQ_U32(ll_var_peek_front_bytes(ll, &ptr, &len), LL_OK);
+    CUU_ASSERT_EQ_U32(len, sizeof(large));
+    CUU_ASSERT(ptr == ll->head->data);
+    CUU_ASSERT_EQ_U32(ll_var_peek_bytes(ll, &ptr, &len), LL_OK);
+    CUU_ASSERT_EQ_U32(len, 0);
+
+    u8 out[512];
+    CUU_ASSERT_EQ_U32(ll_var_pop_bytes(ll, out, sizeof(out), &len), LL_OK);
+    CUU_ASSERT_EQ_U32(len, 0);
+    CUU_ASSERT_EQ_U32(ll_var_pop_bytes(ll, out, sizeof(out), &len), LL_OK);
+    CUU_ASSERT_EQ_U32(len, sizeof(medium));
+    CUU_ASSERT(memcmp(out, medium, sizeof(medium)) == 0);
+
+    // a payload that doesn't fit is kept
+    CUU_ASSERT_EQ_U32(ll_var_pop_front_bytes(ll, out, sizeof(out), &len), LL_ERROR_INSUFFICIENT_SIZE);
+    CUU_ASSERT_EQ_U32(len, sizeof(large));
+    CUU_ASSERT_EQ_U32(ll->len, 2);
+    CUU_ASSERT_EQ_U32(ll_var_pop_front_bytes(ll, NULL, 0, NULL), LL_OK);
+    CUU_ASSERT_EQ_U32(ll->large_nodes, 0);
+    CUU_ASSERT_EQ_U32(ll_var_pop_front_bytes(ll, out, sizeof(out), &len), LL_OK);
+    CUU_ASSERT_EQ_U32(len, 2);
+    CUU_ASSERT(memcmp(out, small, 2) == 0);
+    CUU_ASSERT_EQ_U32(ll_var_pop_bytes(ll, out, sizeof(out), &len), LL_ERROR_EMPTY_LINKED_LIST);
+
+    // freeing with large nodes still linked
+    for (u32 i = 0; i < 100; i++) ll_var_push_bytes(ll, large, i * 50);
+    CUU_ASSERT_EQ_U32(ll_var_free(&ll), LL_OK);
+    CUU_ASSERT_PTR_NULL(ll);
+}
+
+void test_stats(void) {
+    ll_LinkedList *ll = assert_new(/*data_size*/ 4);
+    ll_Stats stats;
+
+#ifdef LL_STATS
+    for (u32 i = 0; i < 10; i++) ll_push(ll, &i);
+    CUU_ASSERT(assert_get_u32(ll, 2, 2));
+    CUU_ASSERT(assert_get_u32(ll, 8, 8));
+    CUU_ASSERT(assert_pop_front_u32(ll, 0));
+    CUU_ASSERT_EQ_U32(ll_stats_get(ll, &stats), LL_OK);
+    CUU_ASSERT_EQ_U32(stats.ops[LL_OP_PUSH], 10);
+    CUU_ASSERT_EQ_U32(stats.ops[LL_OP_GET], 2);
+    CUU_ASSERT_EQ_U32(stats.ops[LL_OP_POP_FRONT], 1);
+    CUU_ASSERT_EQ_U32(stats.traversal_steps, 2 + 1);
+    CUU_ASSERT_EQ_U32(stats.tail_traversals, 1);
+    CUU_ASSERT_EQ_U32(stats.node_allocs, 10);
+    CUU_ASSERT_EQ_U32(stats.node_frees, 1);
+    CUU_ASSERT_EQ_U32(stats.bytes_copied, 13 * 4);
+    CUU_ASSERT_EQ_U32(stats.len_high_water, 10);
+
+    CUU_ASSERT_EQ_U32(ll_stats_reset(ll), LL_OK);
+    CUU_ASSERT_EQ_U32(ll_stats_get(ll, &stats), LL_OK);
+    CUU_ASSERT_EQ_U32(stats.ops[LL_OP_PUSH], 0);
+    CUU_ASSERT_EQ_U32(stats.len_high_water, 9);
+
+    // a reversed list counts the call made, not the physical end it lands on
+    CUU_ASSERT_EQ_U32(ll_reverse(ll), LL_OK);
+    CUU_ASSERT_EQ_U32(ll_stats_reset(ll), LL_OK);
+    u32 elem = 42;
+    CUU_ASSERT_EQ_U32(ll_push(ll, &elem), LL_OK);
+    CUU_ASSERT_EQ_U32(ll_pop(ll, NULL), LL_OK);
+    CUU_ASSERT_EQ_U32(ll_pop_front(ll, NULL), LL_OK);
+    CUU_ASSERT_EQ_U32(ll_stats_get(ll, &stats), LL_OK);
+    CUU_ASSERT_EQ_U32(stats.ops[LL_OP_PUSH], 1);
+    CUU_ASSERT_EQ_U32(stats.ops[LL_OP_POP], 1);
+    CUU_ASSERT_EQ_U32(stats.ops[LL_OP_POP_FRONT], 1);
+    CUU_ASSERT_EQ_U32(stats.ops[LL_OP_PUSH_FRONT], 0);
+
+    // inserts and removes at either end are one operation, not also a push or pop
+    CUU_ASSERT_EQ_U32(ll_stats_reset(ll), LL_OK);
+    CUU_ASSERT_EQ_U32(ll_insert(ll, 0, &elem), LL_OK);
+    CUU_ASSERT_EQ_U32(ll_insert64(ll, ll_len(ll), &elem), LL_OK);
+    CUU_ASSERT_EQ_U32(ll_remove(ll, NULL, 0), LL_OK);
+    CUU_ASSERT_EQ_U32(ll_remove64(ll, NULL, ll_len(ll) - 1), LL_OK);
+    CUU_ASSERT_EQ_U32(ll_stats_get(ll, &stats), LL_OK);
+    CUU_ASSERT_EQ_U32(stats.ops[LL_OP_INSERT], 2);
+    CUU_ASSERT_EQ_U32(stats.ops[LL_OP_REMOVE], 2);
+    for (u32 op = 0; op < LL_OP_COUNT; op++) {
+        if (op != LL_OP_INSERT && op != LL_OP_REMOVE) CUU_ASSERT_EQ_U32(stats.ops[op], 0);
+    }
+#else
+    CUU_ASSERT_EQ_U32(ll_stats_get(ll, &stats), LL_ERROR_UNSUPPORTED);
+    CUU_ASSERT_EQ_U32(ll_stats_reset(ll), LL_ERROR_UNSUPPORTED);
+#endif
+
+    ll_free(&ll);
+}
+
+#ifdef LL_TRACE
+static u32 trace_enters, trace_exits;
+static ll_Error trace_last_status;
+
+static void trace_enter(ll_Op op, i64 index, size_t len, void *ctx) {
+    trace_enters++;
+}
+
+static void trace_exit(ll_Op op, i64 index, size_t len, ll_Error status, u64 ticks, void *ctx) {
+    trace_exits++;
+    trace_last_status = status;
+}
+#endif
+
+void test_trace(void) {
+    ll_LinkedList *ll = assert_new(/*data_size*/ 4);
+    ll_Histogram histogram;
+    u64 p999;
+
+#ifdef LL_TRACE
+    ll_TraceHooks hooks = {.enter = trace_enter, .exit = trace_exit};
+    CUU_ASSERT_EQ_U32(ll_trace_reset(), LL_OK);
+    CUU_ASSERT_EQ_U32(ll_trace_set_hooks(&hooks, NULL), LL_OK);
+
+    for (u32 i = 0; i < 100; i++) ll_push(ll, &i);
+    // delegated to ll_push internally, but only traced as an insert
+    CUU_ASSERT(assert_insert_u32(ll, 100, 100));
+    CUU_ASSERT(assert_get_u32_error(ll, 500, LL_ERROR_INDEX_OUT_OF_BOUNDS));
+    CUU_ASSERT_EQ_U32(trace_last_status, LL_ERROR_INDEX_OUT_OF_BOUNDS);
+
+    CUU_ASSERT_EQ_U32(ll_trace_histogram(LL_OP_PUSH, &histogram), LL_OK);
+    CUU_ASSERT_EQ_U32(histogram.count, 100);
+    u64 bucketed = 0;
+    for (u32 i = 0; i < LL_TRACE_BUCKETS; i++) bucketed += histogram.buckets[i];
+    CUU_ASSERT_EQ_U32(bucketed, 100);
+    CUU_ASSERT_EQ_U32(ll_trace_percentile(LL_OP_PUSH, 99.9, &p999), LL_OK);
+    CUU_ASSERT(p999 <= histogram.max_ticks);
+    CUU_ASSERT_EQ_U32(ll_trace_histogram(LL_OP_INSERT, &histogram), LL_OK);
+    CUU_ASSERT_EQ_U32(histogram.count, 1);
+    CUU_ASSERT_EQ_U32(ll_trace_percentile(LL_OP_POP, 50, &p999), LL_ERROR_EMPTY_LINKED_LIST);
+
+    // insert + iterate_to inside assert_insert_u32, get + 1 failed get
+    CUU_ASSERT_EQ_U32(trace_enters, 100 + 2 + 1);
+    CUU_ASSERT_EQ_U32(trace_exits, trace_enters);
+
+    CUU_ASSERT_EQ_U32(ll_trace_set_hooks(NULL, NULL), LL_OK);
+    ll_pop(ll, NULL);
+    CUU_ASSERT_EQ_U32(trace_exits, 100 + 2 + 1);
+#else
+    CUU_ASSERT_EQ_U32(ll_trace_histogram(LL_OP_PUSH, &histogram), LL_ERROR_UNSUPPORTED);
+    CUU_ASSERT_EQ_U32(ll_trace_percentile(LL_OP_PUSH, 99.9, &p999), LL_ERROR_UNSUPPORTED);
+    CUU_ASSERT_EQ_U32(ll_trace_set_hooks(NULL, NULL), LL_ERROR_UNSUPPORTED);
+#endif
+
+    ll_free(&ll);
+}
+
+void test_allocator(void) {
+    ll_Arena arena;
+    ll_arena_init(&arena, /*block_size*/ 4096);
+
+    // lists living in an arena are dropped with it
+    for (u32 round = 0; round < 3; round++) {
+        ll_LinkedList *a = ll_new_with_allocator(/*data_size*/ 4, &ll_arena_allocator, &arena);
+        ll_LinkedList *b = ll_new_with_allocator(/*data_size*/ 64, &ll_arena_allocator, &arena);
+        if (!CUU_ASSERT_PTR_NOT_NULL(a) || !CUU_ASSERT_PTR_NOT_NULL(b)) break;
+        for (u32 i = 0; i < 1000; i++) {
+            u8 big[64] = {(u8)i};
+            CUU_ASSERT_EQ_U32(ll_push(a, &i), LL_OK);
+            CUU_ASSERT_EQ_U32(ll_push_front(b, big), LL_OK);
+        }
+        CUU_ASSERT(assert_get_u32(a, 777, 777));
+        CUU_ASSERT(assert_pop_front_u32(a, 0));
+        CUU_ASSERT(((uintptr_t)b->head->data & 7) == 0);
+        CUU_ASSERT(arena.blocks != NULL && arena.blocks->next != NULL);
+
+        // ll_free only drops the list, the arena keeps its memory until it's reset
+        CUU_ASSERT_EQ_U32(ll_free(&a), LL_OK);
+        CUU_ASSERT_PTR_NULL(a);
+        CUU_ASSERT_EQ_U32(ll_allocator_bulk_free(&ll_arena_allocator, &arena), LL_OK);
+        CUU_ASSERT(arena.blocks->next == NULL && arena.blocks->used == 0);
+    }
+
+    CUU_ASSERT(((uintptr_t)ll_arena_alloc(&arena, 3) & 15) == 0);
+    CUU_ASSERT(((uintptr_t)ll_arena_alloc(&arena, 3) & 15) == 0);
+    CUU_ASSERT_PTR_NOT_NULL(ll_arena_alloc(&arena, 1 << 20));
+    CUU_ASSERT_EQ_U32(ll_allocator_bulk_free(&ll_default_allocator, NULL), LL_ERROR_UNSUPPORTED);
+    CUU_ASSERT_PTR_NULL(ll_new_with_allocator(4, NULL, NULL));
+    ll_arena_destroy(&arena);
+    CUU_ASSERT_PTR_NULL(arena.blocks);
+}
+
+void test_error_context(void) {
+    ll_error_set_log_limit(0);
+    ll_error_clear();
+    CUU_ASSERT_PTR_NULL(ll_last_error_context());
+
+    ll_LinkedList *loaded = NULL;
+    CUU_ASSERT_EQ_U32(ll_load(-1, &loaded), LL_ERROR_IO_FAILURE);
+    const ll_ErrorContext *ctx = ll_last_error_context();
+    if (!CUU_ASSERT_PTR_NOT_NULL(ctx)) return;
+    CUU_ASSERT_EQ_U32(ctx->code, LL_ERROR_IO_FAILURE);
+    CUU_ASSERT_EQ_U32(ctx->seq, 1);
+    CUU_ASSERT(strcmp(ctx->func, "ll_load") == 0);
+    CUU_ASSERT(strstr(ctx->file, "lib.c") != NULL);
+
+    // the ring keeps the newest errors
+    for (u32 i = 0; i < 40; i++) ll_load(-1, &loaded);
+    ll_ErrorContext recent[LL_ERROR_RING_SIZE * 2];
+    CUU_ASSERT_EQ_U32(ll_error_contexts(recent, LL_ERROR_RING_SIZE * 2), LL_ERROR_RING_SIZE);
+    CUU_ASSERT_EQ_U32(recent[0].seq, 41);
+    CUU_ASSERT_EQ_U32(recent[LL_ERROR_RING_SIZE - 1].seq, 41 - LL_ERROR_RING_SIZE + 1);
+    CUU_ASSERT_EQ_U32(ll_error_contexts(recent, 2), 2);
+
+    ll_error_clear();
+    ll_error_set_log_limit(16);
+}
+
+void test_large_index(void) {
+    ll_LinkedList *ll = assert_new(/*data_size*/ 4);
+    for (u32 i = 0; i < 8; i++) CUU_ASSERT_EQ_U32(ll_push(ll, &i), LL_OK);
+
+    // the size_t API and the int API agree within range
+    u32 out = 0;
+    u32 elem = 0x55;
+    CUU_ASSERT_EQ_U32(ll_get64(ll, &out, 6), LL_OK);
+    CUU_ASSERT_EQ_U32(out, 6);
+    CUU_ASSERT_EQ_U32(ll_set64(ll, 1, &elem), LL_OK);
+    CUU_ASSERT(assert_get_u32(ll, 1, 0x55));
+    CUU_ASSERT_EQ_U32(ll_insert64(ll, 8, &elem), LL_OK);
+    CUU_ASSERT_EQ_U32(ll_remove64(ll, &out, 8), LL_OK);
+    CUU_ASSERT_EQ_U32(out, 0x55);
+
+    // indices beyond INT_MAX and negative int indices are out of bounds rather than wrapped
+    struct ll_LinkedListNode *node = NULL;
+    CUU_ASSERT_EQ_U32(iterate_to64(ll, &node, (size_t)INT32_MAX + 1), LL_ERROR_INDEX_OUT_OF_BOUNDS);
+    CUU_ASSERT_EQ_U32(ll_get64(ll, &out, SIZE_MAX), LL_ERROR_INDEX_OUT_OF_BOUNDS);
+    CUU_ASSERT_EQ_U32(ll_insert64(ll, SIZE_MAX, &elem), LL_ERROR_INDEX_OUT_OF_BOUNDS);
+    CUU_ASSERT(assert_get_u32_error(ll, -1, LL_ERROR_INDEX_OUT_OF_BOUNDS));
+    CUU_ASSERT(assert_insert_u32_error(ll, INT32_MIN, 0x404, LL_ERROR_INDEX_OUT_OF_BOUNDS));
+    CUU_ASSERT(assert_remove_u32_error(ll, -8, LL_ERROR_INDEX_OUT_OF_BOUNDS));
+    CUU_ASSERT_EQ_U32(ll->len, 8);
+    ll_free(&ll);
+
+#ifdef LL_TEST_HUGE
+    // more than 2^31 zero sized elements, about 32 GiB of nodes. enabled with `make test LL_TEST_HUGE=1`.
+    const size_t huge_len = ((size_t)1 << 31) + 3;
+    ll_LinkedList *huge = assert_new(/*data_size*/ 0);
+    for (size_t i = 0; i < huge_len; i++) {
+        if (ll_push(huge, &elem) != LL_OK) break;
+    }
+    CUU_ASSERT(huge->len == huge_len);
+    CUU_ASSERT_EQ_U32(iterate_to64(huge, &node, huge_len - 2), LL_OK);
+    CUU_ASSERT(node == huge->tail->prev);
+    CUU_ASSERT_EQ_U32(iterate_to64(huge, &node, (size_t)1 << 31), LL_OK);
+    CUU_ASSERT_EQ_U32(ll_remove64(huge, &out, (size_t)1 << 31), LL_OK);
+    CUU_ASSERT(huge->len == huge_len - 1);
+    CUU_ASSERT_EQ_U32(ll_get64(huge, &out, huge_len - 1), LL_ERROR_INDEX_OUT_OF_BOUNDS);
+    ll_free(&huge);
+#endif
+}
+
+void test_xor_list(void) {
+    ll_XorLinkedList *ll = ll_xor_new(/*data_size*/ 4);
+    if (!CUU_ASSERT_PTR_NOT_NULL(ll)) return;
+    CUU_ASSERT_EQ_U32(ll->pool.node_size, 16);
+
+    // 2 1 0 3 4 5 ... 9
+    for (u32 i = 3; i < 10; i++) CUU_ASSERT_EQ_U32(ll_xor_push(ll, &i), LL_OK);
+    for (u32 i = 3; i-- > 0;) CUU_ASSERT_EQ_U32(ll_xor_push_front(ll, &i), LL_OK);
+    CUU_ASSERT_EQ_U32(ll->len, 10);
+
+    // walk forward, turn around halfway and walk back to the head
+    ll_XorCursor cursor;
+    u32 out = 0;
+    CUU_ASSERT_EQ_U32(ll_xor_cursor_front(ll, &cursor), LL_OK);
+    for (u32 i = 0; i < 5; i++) {
+        CUU_ASSERT_EQ_U32(ll_xor_cursor_get(&cursor, &out), LL_OK);
+        CUU_ASSERT_EQ_U32(out, i);
+        CUU_ASSERT_EQ_U32(ll_xor_cursor_next(&cursor), LL_OK);
+    }
+    CUU_ASSERT_EQ_U32(ll_xor_cursor_reverse(&cursor), LL_OK);
+    for (u32 i = 6; i-- > 0;) {
+        CUU_ASSERT_EQ_U32(ll_xor_cursor_get(&cursor, &out), LL_OK);
+        CUU_ASSERT_EQ_U32(out, i);
+        CUU_ASSERT_EQ_U32(ll_xor_cursor_next(&cursor), LL_OK);
+    }
+    CUU_ASSERT_PTR_NULL(cursor.node);
+    CUU_ASSERT_EQ_U32(ll_xor_cursor_next(&cursor), LL_ERROR_INDEX_OUT_OF_BOUNDS);
+    CUU_ASSERT_EQ_U32(ll_xor_cursor_get(&cursor, &out), LL_ERROR_INDEX_OUT_OF_BOUNDS);
+
+    CUU_ASSERT_EQ_U32(ll_xor_cursor_back(ll, &cursor), LL_OK);
+    for (u32 i = 10; i-- > 0;) {
+        CUU_ASSERT_EQ_U32(ll_xor_cursor_get(&cursor, &out), LL_OK);
+        CUU_ASSERT_EQ_U32(out, i);
+        ll_xor_cursor_next(&cursor);
+    }
+    CUU_ASSERT_PTR_NULL(cursor.node);
+
+    // drain from both ends
+    for (u32 i = 0; i < 5; i++) {
+        CUU_ASSERT_EQ_U32(ll_xor_pop_front(ll, &out), LL_OK);
+        CUU_ASSERT_EQ_U32(out, i);
+        CUU_ASSERT_EQ_U32(ll_xor_pop(ll, &out), LL_OK);
+        CUU_ASSERT_EQ_U32(out, 9 - i);
+    }
+    CUU_ASSERT_EQ_U32(ll_xor_pop(ll, &out), LL_ERROR_EMPTY_LINKED_LIST);
+    CUU_ASSERT_EQ_U32(ll_xor_pop_front(ll, NULL), LL_ERROR_EMPTY_LINKED_LIST);
+    CUU_ASSERT(ll->head == NULL && ll->tail == NULL && ll->len == 0);
+
+    CUU_ASSERT_EQ_U32(ll_xor_push_front(ll, &out), LL_OK);
+    CUU_ASSERT_EQ_U32(ll_xor_pop(ll, NULL), LL_OK);
+    CUU_ASSERT_EQ_U32(ll_xor_free(&ll), LL_OK);
+    CUU_ASSERT_PTR_NULL(ll);
+}
+
+// an object on two lists at once
+typedef struct {
+    u32 id;
+    ll_Link by_age;
+    ll_Link by_name;
+}TestIntrusiveItem;
+
+void test_intrusive_list(void) {
+    TestIntrusiveItem items[4] = {{0}};
+    ll_IntrusiveList by_age, by_name;
+    CUU_ASSERT_EQ_U32(ll_intrusive_init(&by_age), LL_OK);
+    CUU_ASSERT_EQ_U32(ll_intrusive_init(&by_name), LL_OK);
+    CUU_ASSERT_PTR_NULL(ll_intrusive_first(&by_age));
+
+    for (u32 i = 0; i < 4; i++) {
+        items[i].id = i;
+        CUU_ASSERT_EQ_U32(ll_intrusive_push(&by_age, &items[i].by_age), LL_OK);
+        CUU_ASSERT_EQ_U32(ll_intrusive_push_front(&by_name, &items[i].by_name), LL_OK);
+    }
+    CUU_ASSERT_EQ_U32(ll_intrusive_push(&by_name, &items[0].by_name), LL_ERROR_INVALID_LINK);
+    CUU_ASSERT_EQ_U32(by_age.len, 4);
+
+    // the same objects are reachable in a different order from each list
+    u32 expected = 0;
+    for (ll_Link *link = ll_intrusive_first(&by_age); link != NULL; link = ll_intrusive_next(&by_age, link)) {
+        CUU_ASSERT_EQ_U32(LL_CONTAINER_OF(link, TestIntrusiveItem, by_age)->id, expected++);
+    }
+    CUU_ASSERT_EQ_U32(expected, 4);
+    for (ll_Link *link = ll_intrusive_first(&by_name); link != NULL; link = ll_intrusive_next(&by_name, link)) {
+        CUU_ASSERT_EQ_U32(LL_CONTAINER_OF(link, TestIntrusiveItem, by_name)->id, --expected);
+    }
+
+    // unlinking from one list leaves the other alone: by_age 0 3 1
+    CUU_ASSERT_EQ_U32(ll_intrusive_unlink(&by_age, &items[2].by_age), LL_OK);
+    CUU_ASSERT_EQ_U32(ll_intrusive_unlink(&by_age, &items[2].by_age), LL_ERROR_INVALID_LINK);
+    CUU_ASSERT(ll_link_is_linked(&items[2].by_name));
+    CUU_ASSERT_EQ_U32(ll_intrusive_unlink(&by_age, &items[3].by_age), LL_OK);
+    CUU_ASSERT_EQ_U32(ll_intrusive_link_after(&by_age, &items[0].by_age, &items[3].by_age), LL_OK);
+    CUU_ASSERT_EQ_U32(ll_intrusive_link_before(&by_age, &items[2].by_age, &items[1].by_age), LL_ERROR_INVALID_LINK);
+    CUU_ASSERT_EQ_U32(ll_intrusive_unlink(&by_age, &items[1].by_age), LL_OK);
+    CUU_ASSERT_EQ_U32(ll_intrusive_link_before(&by_age, &by_age.root, &items[1].by_age), LL_OK);
+
+    ll_Link *out = NULL;
+    u32 order[] = {0, 3, 1};
+    for (u32 i = 0; i < 3; i++) {
+        CUU_ASSERT_EQ_U32(ll_intrusive_pop_front(&by_age, &out), LL_OK);
+        CUU_ASSERT_EQ_U32(LL_CONTAINER_OF(out, TestIntrusiveItem, by_age)->id, order[i]);
+        CUU_ASSERT(!ll_link_is_linked(out));
+    }
+    CUU_ASSERT_EQ_U32(ll_intrusive_pop(&by_age, &out), LL_ERROR_EMPTY_LINKED_LIST);
+
+    CUU_ASSERT_EQ_U32(ll_intrusive_pop(&by_name, &out), LL_OK);
+    CUU_ASSERT(out == &items[0].by_name);
+    CUU_ASSERT_EQ_U32(by_name.len, 3);
+}
+
+void test_snapshot(void) {
+    ll_LinkedList *ll = assert_new(/*data_size*/ 4);
+    for (u32 i = 0; i < 100; i++) CUU_ASSERT_EQ_U32(ll_push(ll, &i), LL_OK);
+
+    // snapshots without a mutation in between are shared
+    ll_Snapshot *snap = ll_snapshot(ll);
+    if (!CUU_ASSERT_PTR_NOT_NULL(snap)) return;
+    ll_Snapshot *same = ll_snapshot(ll);
+    CUU_ASSERT(same == snap);
+    CUU_ASSERT(snap->head == ll->head);
+    CUU_ASSERT_EQ_U32(ll_snapshot_release(&same), LL_OK);
+    CUU_ASSERT_PTR_NULL(same);
+
+    // mutations leave the snapshot as it was
+    u32 elem = 0x404;
+    CUU_ASSERT_EQ_U32(ll_push(ll, &elem), LL_OK);
+    CUU_ASSERT(snap->head != ll->head);
+    CUU_ASSERT(assert_pop_front_u32(ll, 0));
+    CUU_ASSERT(assert_set_u32(ll, 5, 0x555));
+    CUU_ASSERT(assert_remove_u32(ll, 50, 51));
+    u32 out = 0;
+    CUU_ASSERT_EQ_U32(snap->len, 100);
+    for (u32 i = 0; i < 100; i++) {
+        CUU_ASSERT_EQ_U32(ll_snapshot_get(snap, &out, i), LL_OK);
+        CUU_ASSERT_EQ_U32(out, i);
+    }
+    CUU_ASSERT_EQ_U32(ll_snapshot_get(snap, &out, 100), LL_ERROR_INDEX_OUT_OF_BOUNDS);
+    CUU_ASSERT(assert_get_u32(ll, 5, 0x555));
+    CUU_ASSERT(assert_get_u32(ll, 98, 0x404));
+
+    // a snapshot released before the next mutation costs no copy
+    ll_Snapshot *unused = ll_snapshot(ll);
+    struct ll_LinkedListNode *head = ll->head;
+    CUU_ASSERT_EQ_U32(ll_snapshot_release(&unused), LL_OK);
+    CUU_ASSERT(assert_push_u32(ll, 0x123));
+    CUU_ASSERT(ll->head == head && ll->snapshot == NULL);
+
+    // snapshots outlive their list
+    ll_Snapshot *last = ll_snapshot(ll);
+    size_t len = ll->len;
+    CUU_ASSERT_EQ_U32(ll_free(&ll), LL_OK);
+    CUU_ASSERT_EQ_U32(last->len, len);
+    CUU_ASSERT_EQ_U32(ll_snapshot_get(last, &out, len - 1), LL_OK);
+    CUU_ASSERT_EQ_U32(out, 0x123);
+    CUU_ASSERT_EQ_U32(ll_snapshot_release(&last), LL_OK);
+    CUU_ASSERT_EQ_U32(ll_snapshot_release(&snap), LL_OK);
+    CUU_ASSERT_EQ_U32(ll_snapshot_release(&snap), LL_ERROR_NULL_LINKED_LIST_POINTER);
+}
+
+void test_insert_remove_many(void) {
+    ll_LinkedList *ll = assert_new(/*data_size*/ 4);
+    for (u32 i = 0; i < 10; i++) CUU_ASSERT_EQ_U32(ll_push(ll, &i), LL_OK);
+
+    // indices are positions before the batch, ties keep their order
+    const int insert_at[] = {10, 0, 5, 5, 3};
+    const u32 elems[] = {0xA, 0xB, 0xC, 0xD, 0xE};
+    CUU_ASSERT_EQ_U32(ll_insert_many_at(ll, insert_at, elems, 5), LL_OK);
+    const u32 inserted[] = {0xB, 0, 1, 2, 0xE, 3, 4, 0xC, 0xD, 5, 6, 7, 8, 9, 0xA};
+    CUU_ASSERT_EQ_U32(ll->len, 15);
+    for (u32 i = 0; i < 15; i++) CUU_ASSERT(assert_get_u32(ll, i, inserted[i]));
+    CUU_ASSERT(ll->head->prev == NULL && ll->tail->next == NULL);
+
+    // nothing changes on a bad batch
+    const int bad_insert[] = {1, 16};
+    CUU_ASSERT_EQ_U32(ll_insert_many_at(ll, bad_insert, elems, 2), LL_ERROR_INDEX_OUT_OF_BOUNDS);
+    const int repeated[] = {3, 1, 3};
+    CUU_ASSERT_EQ_U32(ll_remove_many_at(ll, repeated, NULL, 3), LL_ERROR_INDEX_OUT_OF_BOUNDS);
+    const int bad_remove[] = {-1};
+    CUU_ASSERT_EQ_U32(ll_remove_many_at(ll, bad_remove, NULL, 1), LL_ERROR_INDEX_OUT_OF_BOUNDS);
+    CUU_ASSERT_EQ_U32(ll->len, 15);
+
+    // removed elements are written in the order of the indices
+    const int remove_at[] = {14, 0, 7};
+    u32 out[3] = {0};
+    CUU_ASSERT_EQ_U32(ll_remove_many_at(ll, remove_at, out, 3), LL_OK);
+    CUU_ASSERT(out[0] == 0xA && out[1] == 0xB && out[2] == 0xC);
+    const u32 removed[] = {0, 1, 2, 0xE, 3, 4, 0xD, 5, 6, 7, 8, 9};
+    CUU_ASSERT_EQ_U32(ll->len, 12);
+    for (u32 i = 0; i < 12; i++) CUU_ASSERT(assert_get_u32(ll, i, removed[i]));
+    CUU_ASSERT(assert_pop_u32(ll, 9));
+
+    // emptying and refilling from empty
+    const int all[] = {10, 0, 5, 1, 2, 3, 4, 6, 7, 8, 9};
+    CUU_ASSERT_EQ_U32(ll_remove_many_at(ll, all, NULL, 11), LL_OK);
+    CUU_ASSERT(ll_is_empty(ll));
+    const int zeros[] = {0, 0};
+    CUU_ASSERT_EQ_U32(ll_insert_many_at(ll, zeros, elems, 2), LL_OK);
+    CUU_ASSERT(assert_pop_front_u32(ll, 0xA));
+    CUU_ASSERT(assert_pop_front_u32(ll, 0xB));
+    CUU_ASSERT(assert_pop_empty_u32(ll));
+    ll_free(&ll);
+}
+
+void test_bulk_copy(void) {
+    u32 src[1000], dst[1000];
+    for (u32 i = 0; i < 1000; i++) src[i] = i * 3;
+
+    ll_LinkedList *ll = ll_from_array(sizeof(u32), src, 1000);
+    if (!CUU_ASSERT_PTR_NOT_NULL(ll)) return;
+    CUU_ASSERT_EQ_U32(ll->len, 1000);
+    CUU_ASSERT(assert_get_u32(ll, 999, 999 * 3));
+    CUU_ASSERT(assert_pop_front_u32(ll, 0));
+    CUU_ASSERT(assert_push_u32(ll, 0x404));
+
+    memset(dst, 0, sizeof(dst));
+    CUU_ASSERT_EQ_U32(ll_to_array(ll, dst), LL_OK);
+    CUU_ASSERT(memcmp(dst, src + 1, 999 * sizeof(u32)) == 0);
+    CUU_ASSERT_EQ_U32(dst[999], 0x404);
+
+    // ranges starting near the tail are found from it
+    memset(dst, 0, sizeof(dst));
+    CUU_ASSERT_EQ_U32(ll_copy_range(ll, 900, 100, dst), LL_OK);
+    CUU_ASSERT(memcmp(dst, src + 901, 99 * sizeof(u32)) == 0);
+    CUU_ASSERT_EQ_U32(dst[99], 0x404);
+    CUU_ASSERT_EQ_U32(ll_copy_range(ll, 900, 101, dst), LL_ERROR_INDEX_OUT_OF_BOUNDS);
+    CUU_ASSERT_EQ_U32(ll_copy_range(ll, SIZE_MAX, 2, dst), LL_ERROR_INDEX_OUT_OF_BOUNDS);
+    CUU_ASSERT_EQ_U32(ll_copy_range(ll, 1000, 0, NULL), LL_OK);
+    ll_free(&ll);
+
+    // odd element sizes and empty arrays
+    const char text[] = "abcdefghi";
+    ll = ll_from_array(3, text, 3);
+    if (!CUU_ASSERT_PTR_NOT_NULL(ll)) return;
+    char out[10] = {0};
+    CUU_ASSERT_EQ_U32(ll_copy_range(ll, 1, 2, out), LL_OK);
+    CUU_ASSERT(strcmp(out, "defghi") == 0);
+    ll_free(&ll);
+    ll = ll_from_array(4, NULL, 0);
+    CUU_ASSERT(ll != NULL && ll_is_empty(ll));
+    CUU_ASSERT_EQ_U32(ll_to_array(ll, NULL), LL_OK);
+    ll_free(&ll);
+    CUU_ASSERT_PTR_NULL(ll_from_array(4, NULL, 1));
+}
+
+void test_node_arena(void) {
+    ll_NodeArena arena;
+    CUU_ASSERT_EQ_U32(ll_node_arena_init(&arena, /*data_size*/ 4, /*initial_capacity*/ 0), LL_OK);
+    CUU_ASSERT_EQ_U32(arena.node_size, 12);
+
+    // many short lists sharing the arena, which grows past its initial capacity
+    enum { LISTS = 1000 };
+    static ll_ArenaList lists[LISTS];
+    for (u32 l = 0; l < LISTS; l++) {
+        lists[l] = (ll_ArenaList)LL_ARENA_LIST_INIT;
+        for (u32 i = 0; i < 4; i++) {
+            u32 elem = l * 10 + i;
+            CUU_ASSERT_EQ_U32(i % 2 ? ll_arena_list_push(&arena, &lists[l], &elem)
+                                    : ll_arena_list_push_front(&arena, &lists[l], &elem), LL_OK);
+        }
+    }
+    CUU_ASSERT_EQ_U32(arena.used, LISTS * 4 + 1);
+    CUU_ASSERT_EQ_U32(lists[7].len, 4);
+
+    // 2 0 1 3 for every list, walked by index
+    const u32 order[] = {2, 0, 1, 3};
+    u32 node = lists[7].head;
+    for (u32 i = 0; i < 4; i++, node = ll_node_arena_next(&arena, node)) {
+        CUU_ASSERT_EQ_U32(*(u32*)ll_node_arena_data(&arena, node), 70 + order[i]);
+    }
+    CUU_ASSERT_EQ_U32(node, LL_ARENA_NIL);
+    CUU_ASSERT_EQ_U32(ll_node_arena_prev(&arena, lists[7].head), LL_ARENA_NIL);
+
+    u32 out = 0;
+    CUU_ASSERT_EQ_U32(ll_arena_list_pop(&arena, &lists[3], &out), LL_OK);
+    CUU_ASSERT_EQ_U32(out, 33);
+    CUU_ASSERT_EQ_U32(ll_arena_list_pop_front(&arena, &lists[3], &out), LL_OK);
+    CUU_ASSERT_EQ_U32(out, 32);
+    CUU_ASSERT_EQ_U32(ll_arena_list_pop_front(&arena, &lists[3], NULL), LL_OK);
+    CUU_ASSERT_EQ_U32(ll_arena_list_pop(&arena, &lists[3], &out), LL_OK);
+    CUU_ASSERT_EQ_U32(out, 31);
+    CUU_ASSERT_EQ_U32(ll_arena_list_pop(&arena, &lists[3], &out), LL_ERROR_EMPTY_LINKED_LIST);
+    CUU_ASSERT(lists[3].head == LL_ARENA_NIL && lists[3].tail == LL_ARENA_NIL);
+
+    // freed nodes are reused before the arena grows
+    CUU_ASSERT_EQ_U32(ll_arena_list_clear(&arena, &lists[5]), LL_OK);
+    CUU_ASSERT_EQ_U32(lists[5].len, 0);
+    u32 used = arena.used;
+    for (u32 i = 0; i < 8; i++) CUU_ASSERT_EQ_U32(ll_arena_list_push(&arena, &lists[3], &i), LL_OK);
+    CUU_ASSERT_EQ_U32(arena.used, used);
+    CUU_ASSERT_EQ_U32(ll_arena_list_push(&arena, &lists[3], &out), LL_OK);
+    CUU_ASSERT_EQ_U32(arena.used, used + 1);
+
+    // every list is dropped at once
+    CUU_ASSERT_EQ_U32(ll_node_arena_reset(&arena), LL_OK);
+    CUU_ASSERT_EQ_U32(arena.used, 1);
+    CUU_ASSERT_EQ_U32(ll_node_arena_destroy(&arena), LL_OK);
+    CUU_ASSERT_PTR_NULL(arena.nodes);
+
+    CUU_ASSERT_EQ_U32(ll_node_arena_init(&arena, /*data_size*/ 16, 0), LL_OK);
+    CUU_ASSERT_EQ_U32(arena.node_size, 24);
+    ll_node_arena_destroy(&arena);
+}
+
+void test_shrink(void) {
+    ll_LinkedList *ll = assert_new(/*data_size*/ 4);
+    for (u32 i = 0; i < 10000; i++) CUU_ASSERT_EQ_U32(ll_push(ll, &i), LL_OK);
+    for (u32 i = 0; i < 9990; i++) CUU_ASSERT(assert_pop_front_u32(ll, i));
+
+    ll_MemoryUsage usage;
+    CUU_ASSERT_EQ_U32(ll_memory_usage(ll, &usage), LL_OK);
+    CUU_ASSERT_EQ_U32(usage.payload_bytes, 10 * 4);
+    CUU_ASSERT_EQ_U32(usage.link_bytes, 10 * (ll->pool.node_size - 4));
+    CUU_ASSERT(usage.slack_bytes >= 9990 * ll->pool.node_size);
+    CUU_ASSERT_EQ_U32(usage.total_bytes,
+                      usage.payload_bytes + usage.link_bytes + usage.header_bytes + usage.slack_bytes);
+
+    // the survivors end up in one dense slab
+    size_t reclaimed = 0;
+    CUU_ASSERT_EQ_U32(ll_shrink(ll, &reclaimed), LL_OK);
+    ll_MemoryUsage shrunk;
+    CUU_ASSERT_EQ_U32(ll_memory_usage(ll, &shrunk), LL_OK);
+    CUU_ASSERT_EQ_U32(shrunk.slack_bytes, 0);
+    CUU_ASSERT_EQ_U32(reclaimed, usage.total_bytes - shrunk.total_bytes);
+    CUU_ASSERT(ll->pool.slabs != NULL && ll->pool.slabs->next == NULL);
+    for (u32 i = 0; i < 10; i++) CUU_ASSERT(assert_get_u32(ll, i, 9990 + i));
+    CUU_ASSERT(assert_push_u32(ll, 0x404));
+    CUU_ASSERT(assert_pop_u32(ll, 0x404));
+
+    // shared nodes are only copied
+    ll_Snapshot *snap = ll_snapshot(ll);
+    CUU_ASSERT_EQ_U32(ll_shrink(ll, &reclaimed), LL_OK);
+    CUU_ASSERT_EQ_U32(reclaimed, 0);
+    CUU_ASSERT(snap->head != ll->head);
+    ll_snapshot_release(&snap);
+
+    while (ll->len > 0) ll_pop(ll, NULL);
+    CUU_ASSERT_EQ_U32(ll_shrink(ll, NULL), LL_OK);
+    CUU_ASSERT_PTR_NULL(ll->pool.slabs);
+    ll_free(&ll);
+
+    // arena backed lists give their pages back to the OS
+    ll_Arena arena;
+    ll_arena_init(&arena, 1 << 16);
+    ll = ll_new_with_allocator(/*data_size*/ 64, &ll_arena_allocator, &arena);
+    if (!CUU_ASSERT_PTR_NOT_NULL(ll)) return;
+    u8 elem[64] = {0};
+    for (u32 i = 0; i < 20000; i++) {
+        elem[0] = (u8)i;
+        ll_push(ll, elem);
+    }
+    for (u32 i = 0; i < 19999; i++) ll_pop(ll, NULL);
+    CUU_ASSERT_EQ_U32(ll_shrink(ll, &reclaimed), LL_OK);
+    CUU_ASSERT(reclaimed > 1000000);
+    CUU_ASSERT_EQ_U32(ll->len, 1);
+    CUU_ASSERT_EQ_U32(ll->head->data[0], 0);
+    ll_arena_destroy(&arena);
+}
+
+void test_small_list(void) {
+    ll_LinkedList *ll = ll_new_small(/*data_size*/ 4, /*inline_count*/ 4);
+    if (!CUU_ASSERT_PTR_NOT_NULL(ll)) return;
+    const struct ll_PoolSlab *inline_slab = ll->pool.inline_slab;
+    CUU_ASSERT((const void*)inline_slab == (const void*)(ll + 1));
+    ll_MemoryUsage empty;
+    CUU_ASSERT_EQ_U32(ll_memory_usage(ll, &empty), LL_OK);
+
+    // the first nodes need no allocation, and freed ones are reused before spilling
+    for (u32 i = 0; i < 4; i++) CUU_ASSERT(assert_push_u32(ll, i));
+    CUU_ASSERT(assert_pop_front_u32(ll, 0));
+    CUU_ASSERT(assert_push_u32(ll, 4));
+    CUU_ASSERT(ll->pool.slabs == inline_slab);
+    CUU_ASSERT_PTR_NULL(inline_slab->next);
+    ll_MemoryUsage usage;
+    CUU_ASSERT_EQ_U32(ll_memory_usage(ll, &usage), LL_OK);
+    CUU_ASSERT_EQ_U32(usage.total_bytes, empty.total_bytes);
+    CUU_ASSERT_EQ_U32(usage.slack_bytes, 0);
+
+    // past the inline capacity nodes spill to the heap behind the same operations
+    for (u32 i = 5; i < 100; i++) CUU_ASSERT(assert_push_u32(ll, i));
+    CUU_ASSERT(ll->pool.slabs != inline_slab);
+    for (u32 i = 0; i < 96; i++) CUU_ASSERT(assert_get_u32(ll, i, i + 1));
+    for (u32 i = 1; i < 98; i++) CUU_ASSERT(assert_pop_front_u32(ll, i));
+
+    // what fits goes back inline and the heap slabs are released
+    size_t reclaimed = 0;
+    CUU_ASSERT_EQ_U32(ll_shrink(ll, &reclaimed), LL_OK);
+    CUU_ASSERT_EQ_U32(ll_memory_usage(ll, &usage), LL_OK);
+    CUU_ASSERT_EQ_U32(usage.total_bytes, empty.total_bytes);
+    CUU_ASSERT(reclaimed > 0);
+    CUU_ASSERT(ll->pool.slabs == inline_slab);
+    CUU_ASSERT(assert_get_u32(ll, 0, 98));
+    CUU_ASSERT(assert_get_u32(ll, 1, 99));
+
+    // a snapshot never points into the header, it outlives the list
+    ll_Snapshot *snap = ll_snapshot(ll);
+    if (!CUU_ASSERT_PTR_NOT_NULL(snap)) return;
+    CUU_ASSERT(assert_push_u32(ll, 100));
+    CUU_ASSERT(ll->pool.inline_slab == inline_slab);
+    CUU_ASSERT(assert_pop_front_u32(ll, 98));
+    ll_free(&ll);
+    u32 out;
+    CUU_ASSERT_EQ_U32(snap->len, 2);
+    CUU_ASSERT_EQ_U32(ll_snapshot_get(snap, &out, 0), LL_OK);
+    CUU_ASSERT_EQ_U32(out, 98);
+    CUU_ASSERT_EQ_U32(ll_snapshot_get(snap, &out, 1), LL_OK);
+    CUU_ASSERT_EQ_U32(out, 99);
+    ll_snapshot_release(&snap);
+}
+
+// orders by the upper 24 bits, the low byte tells where an element came from
+static int compare_merge_keys(const void *a, const void *b) {
+    u32 x = *(const u32*)a >> 8, y = *(const u32*)b >> 8;
+    return (x > y) - (x < y);
+}
+
+void test_merge(void) {
+    ll_LinkedList *a = assert_new(/*data_size*/ 4);
+    ll_LinkedList *b = assert_new(/*data_size*/ 4);
+    for (u32 i = 0; i < 100; i += 2) CUU_ASSERT(assert_push_u32(a, i << 8 | 0xA));
+    for (u32 i = 0; i < 100; i += 3) CUU_ASSERT(assert_push_u32(b, i << 8 | 0xB));
+    struct ll_LinkedListNode *a_head = a->head;
+    size_t len = a->len + b->len;
+
+    // the nodes are relinked, not copied, and equal keys keep #a's first
+    CUU_ASSERT_EQ_U32(ll_merge(a, a, b, compare_merge_keys), LL_OK);
+    CUU_ASSERT_EQ_U32(a->len, len);
+    CUU_ASSERT(ll_is_empty(b));
+    CUU_ASSERT(a->head == a_head);
+    u32 prev = 0, elem;
+    for (size_t i = 0; i < len; i++) {
+        CUU_ASSERT_EQ_U32(ll_get64(a, &elem, i), LL_OK);
+        CUU_ASSERT(elem >> 8 > prev >> 8 || (elem >> 8 == prev >> 8 && (i == 0 || (prev & 0xFF) <= (elem & 0xFF))));
+        prev = elem;
+    }
+    CUU_ASSERT(assert_get_u32(a, 0, 0 << 8 | 0xA));
+    CUU_ASSERT(assert_get_u32(a, 1, 0 << 8 | 0xB));
+    // #b handed its slabs over and is still usable
+    CUU_ASSERT_PTR_NULL(b->pool.slabs);
+    CUU_ASSERT(assert_push_u32(b, 7));
+    CUU_ASSERT(assert_pop_u32(b, 7));
+    CUU_ASSERT_EQ_U32(ll_merge(a, a, a, compare_merge_keys), LL_ERROR_UNSUPPORTED);
+    ll_LinkedList *wide = assert_new(/*data_size*/ 8);
+    CUU_ASSERT_EQ_U32(ll_merge(a, a, wide, compare_merge_keys), LL_ERROR_UNSUPPORTED);
+    ll_free(&wide);
+    ll_free(&b);
+
+    // k-way: more lists than fit on the stack, with small and arena backed ones whose nodes are copied
+    ll_Arena arena;
+    ll_arena_init(&arena, 1 << 16);
+    ll_LinkedList *lists[21] = {a};
+    for (u32 l = 1; l < 21; l++) {
+        if (l % 5 == 1) lists[l] = ll_new_small(/*data_size*/ 4, /*inline_count*/ 4);
+        else if (l % 5 == 2) lists[l] = ll_new_with_allocator(/*data_size*/ 4, &ll_arena_allocator, &arena);
+        else lists[l] = assert_new(/*data_size*/ 4);
+        if (!CUU_ASSERT_PTR_NOT_NULL(lists[l])) return;
+        for (u32 i = l; i < 400; i += l) CUU_ASSERT(assert_push_u32(lists[l], i << 8 | (0x10 + l)));
+        len += lists[l]->len;
+    }
+    // a list passed twice is rejected before anything changes
+    ll_LinkedList *last = lists[20];
+    size_t a_len = a->len, dup_len = lists[7]->len;
+    lists[20] = lists[7];
+    CUU_ASSERT_EQ_U32(ll_merge_k(a, lists, 21, compare_merge_keys), LL_ERROR_UNSUPPORTED);
+    CUU_ASSERT_EQ_U32(ll_merge_k(a, (ll_LinkedList*[]){a, lists[1], a}, 3, compare_merge_keys),
+                      LL_ERROR_UNSUPPORTED);
+    CUU_ASSERT_EQ_U32(a->len, a_len);
+    CUU_ASSERT_EQ_U32(lists[7]->len, dup_len);
+    lists[20] = last;
+    ll_Snapshot *snap = ll_snapshot(lists[3]);
+    size_t snap_len = snap->len;
+    CUU_ASSERT_EQ_U32(ll_merge_k(a, lists, 21, compare_merge_keys), LL_OK);
+    CUU_ASSERT_EQ_U32(a->len, len);
+    CUU_ASSERT_EQ_U32(snap->len, snap_len);
+    ll_snapshot_release(&snap);
+    u32 *all = malloc(len * sizeof(u32));
+    CUU_ASSERT_EQ_U32(ll_to_array(a, all), LL_OK);
+    for (size_t i = 1; i < len; i++) {
+        // equal keys keep the order of the lists, #a's elements being first
+        u32 x = all[i - 1], y = all[i];
+        u32 x_rank = (x & 0xFF) < 0x10 ? 0 : x & 0xFF, y_rank = (y & 0xFF) < 0x10 ? 0 : y & 0xFF;
+        CUU_ASSERT(x >> 8 < y >> 8 || (x >> 8 == y >> 8 && x_rank <= y_rank));
+    }
+    free(all);
+    for (u32 l = 1; l < 21; l++) {
+        CUU_ASSERT(ll_is_empty(lists[l]));
+        CUU_ASSERT(assert_push_u32(lists[l], l));
+        ll_free(&lists[l]);
+    }
+    // the arena's nodes were copied, so #a outlives it
+    ll_arena_destroy(&arena);
+    CUU_ASSERT(assert_pop_front_u32(a, 0 << 8 | 0xA));
+    ll_free(&a);
+}
+
+// checks that the list holds exactly the #n elements of #exp, in order
+static bool assert_elements_u32(const ll_LinkedList *ll, const u32 *exp, u32 n) {
+    if (!CUU_ASSERT_EQ_U32(ll->len, n)) return false;
+    u32 out[64];
+    if (!CUU_ASSERT_EQ_U32(ll_to_array(ll, out), LL_OK)) return false;
+    return CUU_ASSERT(memcmp(out, exp, n * sizeof(u32)) == 0);
+}
+
+void test_transforms(void) {
+    ll_LinkedList *ll = assert_new(/*data_size*/ 4);
+    for (u32 i = 0; i < 6; i++) CUU_ASSERT(assert_push_u32(ll, i));
+
+    // the clone lives in a single run of nodes
+    ll_LinkedList *clone = ll_clone(ll);
+    if (!CUU_ASSERT_PTR_NOT_NULL(clone)) return;
+    CUU_ASSERT(clone->pool.slabs != NULL && clone->pool.slabs->next == NULL);
+    CUU_ASSERT_EQ_U32(clone->pool.slabs->used, 6);
+    CUU_ASSERT(assert_elements_u32(clone, (u32[]){0, 1, 2, 3, 4, 5}, 6));
+
+    // every operation sees the reversed order
+    CUU_ASSERT_EQ_U32(ll_reverse(ll), LL_OK);
+    CUU_ASSERT(assert_elements_u32(ll, (u32[]){5, 4, 3, 2, 1, 0}, 6));
+    CUU_ASSERT(assert_iterate_to_u32(ll, 1, 4));
+    CUU_ASSERT_EQ_U32(ll_push(ll, &(u32){10}), LL_OK);
+    CUU_ASSERT_EQ_U32(ll_push_front(ll, &(u32){11}), LL_OK);
+    CUU_ASSERT(assert_insert_u32(ll, 2, 12));
+    CUU_ASSERT(assert_set_u32(ll, 3, 13));
+    CUU_ASSERT(assert_elements_u32(ll, (u32[]){11, 5, 12, 13, 3, 2, 1, 0, 10}, 9));
+    CUU_ASSERT(assert_remove_u32(ll, 4, 3));
+    CUU_ASSERT(assert_pop_u32(ll, 10));
+    CUU_ASSERT(assert_pop_front_u32(ll, 11));
+    CUU_ASSERT(assert_elements_u32(ll, (u32[]){5, 12, 13, 2, 1, 0}, 6));
+    u32 range[3];
+    CUU_ASSERT_EQ_U32(ll_copy_range(ll, 2, 3, range), LL_OK);
+    CUU_ASSERT(memcmp(range, (u32[]){13, 2, 1}, sizeof(range)) == 0);
+
+    // clones and snapshots of a reversed list read in its order
+    ll_LinkedList *reversed_clone = ll_clone(ll);
+    if (!CUU_ASSERT_PTR_NOT_NULL(reversed_clone)) return;
+    CUU_ASSERT(!reversed_clone->reversed);
+    CUU_ASSERT(assert_elements_u32(reversed_clone, (u32[]){5, 12, 13, 2, 1, 0}, 6));
+    ll_free(&reversed_clone);
+    ll_Snapshot *snap = ll_snapshot(ll);
+    if (!CUU_ASSERT_PTR_NOT_NULL(snap)) return;
+    u32 out;
+    CUU_ASSERT_EQ_U32(ll_snapshot_get(snap, &out, 1), LL_OK);
+    CUU_ASSERT_EQ_U32(out, 12);
+    CUU_ASSERT_EQ_U32(ll_reverse(ll), LL_OK);
+    ll_Snapshot *other = ll_snapshot(ll);
+    if (!CUU_ASSERT_PTR_NOT_NULL(other)) return;
+    CUU_ASSERT(other != snap);
+    CUU_ASSERT_EQ_U32(ll_snapshot_get(other, &out, 1), LL_OK);
+    CUU_ASSERT_EQ_U32(out, 1);
+    CUU_ASSERT_EQ_U32(ll_snapshot_get(snap, &out, 1), LL_OK);
+    CUU_ASSERT_EQ_U32(out, 12);
+    ll_snapshot_release(&snap);
+    ll_snapshot_release(&other);
+    CUU_ASSERT(assert_elements_u32(ll, (u32[]){0, 1, 2, 13, 12, 5}, 6));
+
+    // reversing a shared list, then touching its ends, unshares it first without losing the order
+    ll_LinkedList *shared = assert_new(/*data_size*/ 4);
+    for (u32 i = 0; i < 4; i++) CUU_ASSERT(assert_push_u32(shared, i));
+    for (u32 round = 0; round < 4; round++) {
+        snap = ll_snapshot(shared);
+        CUU_ASSERT_EQ_U32(ll_reverse(shared), LL_OK);
+        if (round == 0) {
+            CUU_ASSERT_EQ_U32(ll_push(shared, &(u32){99}), LL_OK);
+            CUU_ASSERT(assert_elements_u32(shared, (u32[]){3, 2, 1, 0, 99}, 5));
+        } else if (round == 1) {
+            CUU_ASSERT_EQ_U32(ll_pop(shared, &out), LL_OK);
+            CUU_ASSERT_EQ_U32(out, 3);
+            CUU_ASSERT(assert_elements_u32(shared, (u32[]){99, 0, 1, 2}, 4));
+        } else if (round == 2) {
+            CUU_ASSERT_EQ_U32(ll_push_front(shared, &(u32){98}), LL_OK);
+            CUU_ASSERT_EQ_U32(ll_pop_front(shared, &out), LL_OK);
+            CUU_ASSERT_EQ_U32(out, 98);
+            CUU_ASSERT(assert_elements_u32(shared, (u32[]){2, 1, 0, 99}, 4));
+        } else {
+            CUU_ASSERT_EQ_U32(ll_rotate(shared, 1), LL_OK);
+            CUU_ASSERT(assert_elements_u32(shared, (u32[]){0, 1, 2, 99}, 4));
+        }
+        ll_snapshot_release(&snap);
+    }
+    ll_free(&shared);
+
+    // batches put the nodes back in order first
+    CUU_ASSERT_EQ_U32(ll_reverse(ll), LL_OK);
+    CUU_ASSERT_EQ_U32(ll_insert_many_at(ll, (int[]){0, 6}, (u32[]){20, 21}, 2), LL_OK);
+    CUU_ASSERT(!ll->reversed);
+    CUU_ASSERT(assert_elements_u32(ll, (u32[]){20, 5, 12, 13, 2, 1, 0, 21}, 8));
+
+    // rotations either way, of a list in order or reversed
+    CUU_ASSERT_EQ_U32(ll_rotate(ll, 3), LL_OK);
+    CUU_ASSERT(assert_elements_u32(ll, (u32[]){13, 2, 1, 0, 21, 20, 5, 12}, 8));
+    CUU_ASSERT_EQ_U32(ll_rotate(ll, -10), LL_OK);
+    CUU_ASSERT(assert_elements_u32(ll, (u32[]){5, 12, 13, 2, 1, 0, 21, 20}, 8));
+    CUU_ASSERT_EQ_U32(ll_reverse(ll), LL_OK);
+    CUU_ASSERT_EQ_U32(ll_rotate(ll, 1), LL_OK);
+    CUU_ASSERT(assert_elements_u32(ll, (u32[]){21, 0, 1, 2, 13, 12, 5, 20}, 8));
+    CUU_ASSERT_EQ_U32(ll_rotate(ll, -2), LL_OK);
+    CUU_ASSERT(assert_elements_u32(ll, (u32[]){5, 20, 21, 0, 1, 2, 13, 12}, 8));
+    CUU_ASSERT_EQ_U32(ll_rotate(ll, 8), LL_OK);
+    CUU_ASSERT(assert_elements_u32(ll, (u32[]){5, 20, 21, 0, 1, 2, 13, 12}, 8));
+    CUU_ASSERT(assert_pop_u32(ll, 12));
+    CUU_ASSERT(assert_pop_front_u32(ll, 5));
+
+    // small lists clone into their inline storage
+    ll_LinkedList *small = ll_new_small(/*data_size*/ 4, /*inline_count*/ 8);
+    if (!CUU_ASSERT_PTR_NOT_NULL(small)) return;
+    for (u32 i = 0; i < 5; i++) CUU_ASSERT(assert_push_u32(small, i));
+    ll_LinkedList *small_clone = ll_clone(small);
+    if (!CUU_ASSERT_PTR_NOT_NULL(small_clone)) return;
+    CUU_ASSERT(small_clone->pool.slabs == small_clone->pool.inline_slab);
+    CUU_ASSERT(assert_elements_u32(small_clone, (u32[]){0, 1, 2, 3, 4}, 5));
+    CUU_ASSERT_EQ_U32(ll_reverse(NULL), LL_ERROR_NULL_LINKED_LIST_POINTER);
+    CUU_ASSERT_PTR_NULL(ll_clone(NULL));
+
+    ll_free(&small_clone);
+    ll_free(&small);
+    ll_free(&clone);
+    ll_free(&ll);
+}
+
 int init_suite(void) {
     return 0;
 }
@@ -789,6 +3401,28 @@ int main (void) {
     status = CUU_utils_try_add_test(suites[0], test_iterate_to, "\n\nTesting " STR(test_iterate_to) "()\n\n");
     status = CUU_utils_try_add_test(suites[0], test_insert_get_set_remove, "\n\nTesting " STR(test_insert_get_set_remove) "()\n\n");
     status = CUU_utils_try_add_test(suites[0], test_display, "\n\nTesting " STR(test_display) "()\n\n");
+    status = CUU_utils_try_add_test(suites[0], test_save_load, "\n\nTesting " STR(test_save_load) "()\n\n");
+    status = CUU_utils_try_add_test(suites[0], test_mapped_list, "\n\nTesting " STR(test_mapped_list) "()\n\n");
+    status = CUU_utils_try_add_test(suites[0], test_ingest_drain_fd, "\n\nTesting " STR(test_ingest_drain_fd) "()\n\n");
+    status = CUU_utils_try_add_test(suites[0], test_var_list, "\n\nTesting " STR(test_var_list) "()\n\n");
+    status = CUU_utils_try_add_test(suites[0], test_stats, "\n\nTesting " STR(test_stats) "()\n\n");
+    status = CUU_utils_try_add_test(suites[0], test_trace, "\n\nTesting " STR(test_trace) "()\n\n");
+    status = CUU_utils_try_add_test(suites[0], test_allocator, "\n\nTesting " STR(test_allocator) "()\n\n");
+    status = CUU_utils_try_add_test(suites[0], test_error_context, "\n\nTesting " STR(test_error_context) "()\n\n");
+    status = CUU_utils_try_add_test(suites[0], test_large_index, "\n\nTesting " STR(test_large_index) "()\n\n");
+    status = CUU_utils_try_add_test(suites[0], test_xor_list, "\n\nTesting " STR(test_xor_list) "()\n\n");
+    status = CUU_utils_try_add_test(suites[0], test_intrusive_list, "\n\nTesting " STR(test_intrusive_list) "()\n\n");
+    status = CUU_utils_try_add_test(suites[0], test_snapshot, "\n\nTesting " STR(test_snapshot) "()\n\n");
+    status = CUU_utils_try_add_test(suites[0], test_insert_remove_many, "\n\nTesting " STR(test_insert_remove_many) "()\n\n");
+    status = CUU_utils_try_add_test(suites[0], test_bulk_copy, "\n\nTesting " STR(test_bulk_copy) "()\n\n");
+    status = CUU_utils_try_add_test(suites[0], test_node_arena, "\n\nTesting " STR(test_node_arena) "()\n\n");
+    status = CUU_utils_try_add_test(suites[0], test_shrink, "\n\nTesting " STR(test_shrink) "()\n\n");
+    if (status != CUE_SUCCESS) return status;
+    status = CUU_utils_try_add_test(suites[0], test_small_list, "\n\nTesting " STR(test_small_list) "()\n\n");
+    if (status != CUE_SUCCESS) return status;
+    status = CUU_utils_try_add_test(suites[0], test_merge, "\n\nTesting " STR(test_merge) "()\n\n");
+    if (status != CUE_SUCCESS) return status;
+    status = CUU_utils_try_add_test(suites[0], test_transforms, "\n\nTesting " STR(test_transforms) "()\n\n");
     if (status != CUE_SUCCESS) return status;
 
     CU_basic_run_tests(); // OUTPUT to the screen
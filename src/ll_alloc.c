@@ -0,0 +1,88 @@
+#include <stdlib.h>
+#include <stdint.h>
+#include "ll_alloc.h"
+
+// arena allocations are aligned like malloc's
+#define LL_ARENA_ALIGN 16
+
+
+static void* default_alloc(void *ctx, size_t size) {
+    return malloc(size);
+}
+
+static void default_free(void *ctx, void *ptr, size_t size) {
+    free(ptr);
+}
+
+const ll_Allocator ll_default_allocator = {
+    .alloc = default_alloc,
+    .free = default_free,
+    .bulk_free = NULL,
+};
+
+
+static void* arena_alloc(void *ctx, size_t size) {
+    return ll_arena_alloc(ctx, size);
+}
+
+static void arena_bulk_free(void *ctx) {
+    ll_arena_reset(ctx);
+}
+
+const ll_Allocator ll_arena_allocator = {
+    .alloc = arena_alloc,
+    .free = NULL,
+    .bulk_free = arena_bulk_free,
+};
+
+
+/// @param block_size size of the blocks requested from malloc. larger allocations get a block of their own.
+void ll_arena_init(ll_Arena *self, size_t block_size) {
+    self->blocks = NULL;
+    self->block_size = block_size;
+}
+
+
+/// returns #size bytes aligned to 16 bytes, or NULL on failure.
+void* ll_arena_alloc(ll_Arena *self, size_t size) {
+    size = (size + LL_ARENA_ALIGN - 1) & ~(size_t)(LL_ARENA_ALIGN - 1);
+
+    struct ll_ArenaBlock *block = self->blocks;
+    if (block == NULL || block->size - block->used < size) {
+        size_t block_size = size > self->block_size ? size : self->block_size;
+        if (block_size > SIZE_MAX - sizeof(struct ll_ArenaBlock)) return NULL;
+        block = malloc(sizeof(struct ll_ArenaBlock) + block_size);
+        if (block == NULL) return NULL;
+        block->next = self->blocks;
+        block->size = block_size;
+        block->used = 0;
+        self->blocks = block;
+    }
+
+    void *out = block->data + block->used;
+    block->used += size;
+    return out;
+}
+
+
+/// releases every allocation at once. the newest block is kept for reuse so that an arena reset after each
+/// request doesn't go back to malloc.
+void ll_arena_reset(ll_Arena *self) {
+    if (self->blocks == NULL) return;
+
+    struct ll_ArenaBlock *block = self->blocks->next;
+    while (block) {
+        struct ll_ArenaBlock *next = block->next;
+        free(block);
+        block = next;
+    }
+    self->blocks->next = NULL;
+    self->blocks->used = 0;
+}
+
+
+void ll_arena_destroy(ll_Arena *self) {
+    ll_arena_reset(self);
+    free(self->blocks);
+    self->blocks = NULL;
+}
@@ -0,0 +1,81 @@
+#include <stdio.h>
+#include <time.h>
+#include "ll_error.h"
+
+// errors logged to stderr per second and thread by default, see ll_error_set_log_limit
+#ifdef ERROR_RETURN_LOG_DISABLE
+#define LL_ERROR_DEFAULT_LOG_LIMIT 0
+#else
+#define LL_ERROR_DEFAULT_LOG_LIMIT 16
+#endif
+
+static _Thread_local ll_ErrorContext ring[LL_ERROR_RING_SIZE];
+static _Thread_local u64 reported;
+
+static _Thread_local u32 log_limit = LL_ERROR_DEFAULT_LOG_LIMIT;
+static _Thread_local time_t log_window;
+static _Thread_local u32 logged_in_window;
+static _Thread_local u64 suppressed;
+
+
+/// backend of ERROR_RETURN when compiled with ERROR_RETURN_COLD (declared in common_macros.h).
+/// it records the error in the thread's ring and logs it unless too many were logged within the last second.
+__attribute__((cold, noinline))
+void error_return_cold(int error_code, const char *expr, const char *file, int line, const char *func) {
+    reported++;
+    ring[reported % LL_ERROR_RING_SIZE] = (ll_ErrorContext){
+        .code = error_code,
+        .expr = expr,
+        .file = file,
+        .line = line,
+        .func = func,
+        .seq = reported,
+    };
+
+    if (log_limit == 0) return;
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC_COARSE, &ts);
+    if (ts.tv_sec != log_window) {
+        if (suppressed > 0) fprintf(stderr, "%" PRIu64 " more errors were not logged\n", suppressed);
+        log_window = ts.tv_sec;
+        logged_in_window = 0;
+        suppressed = 0;
+    }
+    if (logged_in_window >= log_limit) {
+        suppressed++;
+        return;
+    }
+    logged_in_window++;
+    fprintf(stderr, "%s:%d: %s() :: error: %d (%s)\n", file, line, func, error_code, expr);
+}
+
+
+/// returns the most recent error reported by this thread, or NULL if there's none.
+/// it's valid until the thread reports LL_ERROR_RING_SIZE more errors.
+const ll_ErrorContext* ll_last_error_context(void) {
+    if (reported == 0) return NULL;
+    return &ring[reported % LL_ERROR_RING_SIZE];
+}
+
+
+/// copies up to #max of the thread's recent errors to #out, newest first.
+/// returns the number of errors copied.
+u32 ll_error_contexts(ll_ErrorContext *out, u32 max) {
+    u32 count = 0;
+    for (u64 seq = reported; seq > 0 && count < max && count < LL_ERROR_RING_SIZE; seq--) {
+        out[count++] = ring[seq % LL_ERROR_RING_SIZE];
+    }
+    return count;
+}
+
+
+/// forgets the errors recorded by this thread.
+void ll_error_clear(void) {
+    reported = 0;
+}
+
+
+/// sets how many errors this thread logs to stderr per second. 0 disables logging, errors are still recorded.
+void ll_error_set_log_limit(u32 per_second) {
+    log_limit = per_second;
+}
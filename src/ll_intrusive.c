@@ -0,0 +1,165 @@
+#include "ll_intrusive.h"
+
+
+/// makes #self an empty list.
+/// @returns LL_OK
+///     || LL_ERROR_NULL_LINKED_LIST_POINTER
+ll_Error ll_intrusive_init(ll_IntrusiveList *self) {
+    if (self == NULL) return LL_ERROR_NULL_LINKED_LIST_POINTER;
+    self->root.next = &self->root;
+    self->root.prev = &self->root;
+    self->len = 0;
+    return LL_OK;
+}
+
+
+/// returns whether #link is currently on a list.
+bool ll_link_is_linked(const ll_Link *link) {
+    return link != NULL && link->next != NULL;
+}
+
+
+/// puts the unlinked #link between #prev and #next, which are adjacent.
+static inline void link_between(ll_IntrusiveList *self, ll_Link *prev, ll_Link *next, ll_Link *link) {
+    link->prev = prev;
+    link->next = next;
+    prev->next = link;
+    next->prev = link;
+    self->len++;
+}
+
+static inline void unlink_link(ll_IntrusiveList *self, ll_Link *link) {
+    link->prev->next = link->next;
+    link->next->prev = link->prev;
+    link->next = NULL;
+    link->prev = NULL;
+    self->len--;
+}
+
+
+/// links #link at the tail.
+/// @returns LL_OK
+///     || LL_ERROR_NULL_LINKED_LIST_POINTER
+///     || LL_ERROR_NULL_NODE_POINTER
+///     || LL_ERROR_INVALID_LINK if #link is already on a list
+ll_Error ll_intrusive_push(ll_IntrusiveList *self, ll_Link *link) {
+    if (self == NULL) return LL_ERROR_NULL_LINKED_LIST_POINTER;
+    if (link == NULL) return LL_ERROR_NULL_NODE_POINTER;
+    if (ll_link_is_linked(link)) return LL_ERROR_INVALID_LINK;
+    link_between(self, self->root.prev, &self->root, link);
+    return LL_OK;
+}
+
+
+/// links #link at the head.
+/// @returns LL_OK
+///     || LL_ERROR_NULL_LINKED_LIST_POINTER
+///     || LL_ERROR_NULL_NODE_POINTER
+///     || LL_ERROR_INVALID_LINK if #link is already on a list
+ll_Error ll_intrusive_push_front(ll_IntrusiveList *self, ll_Link *link) {
+    if (self == NULL) return LL_ERROR_NULL_LINKED_LIST_POINTER;
+    if (link == NULL) return LL_ERROR_NULL_NODE_POINTER;
+    if (ll_link_is_linked(link)) return LL_ERROR_INVALID_LINK;
+    link_between(self, &self->root, self->root.next, link);
+    return LL_OK;
+}
+
+
+/// unlinks the tail.
+/// @param out_link set to the unlinked tail, ignored if NULL.
+/// @returns LL_OK
+///     || LL_ERROR_NULL_LINKED_LIST_POINTER
+///     || LL_ERROR_EMPTY_LINKED_LIST
+ll_Error ll_intrusive_pop(ll_IntrusiveList *self, ll_Link **out_link) {
+    if (self == NULL) return LL_ERROR_NULL_LINKED_LIST_POINTER;
+    if (self->len == 0) return LL_ERROR_EMPTY_LINKED_LIST;
+    ll_Link *link = self->root.prev;
+    unlink_link(self, link);
+    if (out_link != NULL) *out_link = link;
+    return LL_OK;
+}
+
+
+/// unlinks the head.
+/// @param out_link set to the unlinked head, ignored if NULL.
+/// @returns LL_OK
+///     || LL_ERROR_NULL_LINKED_LIST_POINTER
+///     || LL_ERROR_EMPTY_LINKED_LIST
+ll_Error ll_intrusive_pop_front(ll_IntrusiveList *self, ll_Link **out_link) {
+    if (self == NULL) return LL_ERROR_NULL_LINKED_LIST_POINTER;
+    if (self->len == 0) return LL_ERROR_EMPTY_LINKED_LIST;
+    ll_Link *link = self->root.next;
+    unlink_link(self, link);
+    if (out_link != NULL) *out_link = link;
+    return LL_OK;
+}
+
+
+/// links #link right before #pos, which must be on #self.
+/// @returns LL_OK
+///     || LL_ERROR_NULL_LINKED_LIST_POINTER
+///     || LL_ERROR_NULL_NODE_POINTER
+///     || LL_ERROR_INVALID_LINK if #link is already on a list or #pos isn't on one
+ll_Error ll_intrusive_link_before(ll_IntrusiveList *self, ll_Link *pos, ll_Link *link) {
+    if (self == NULL) return LL_ERROR_NULL_LINKED_LIST_POINTER;
+    if (pos == NULL || link == NULL) return LL_ERROR_NULL_NODE_POINTER;
+    if (!ll_link_is_linked(pos) || ll_link_is_linked(link)) return LL_ERROR_INVALID_LINK;
+    link_between(self, pos->prev, pos, link);
+    return LL_OK;
+}
+
+
+/// links #link right after #pos, which must be on #self.
+/// @returns LL_OK
+///     || LL_ERROR_NULL_LINKED_LIST_POINTER
+///     || LL_ERROR_NULL_NODE_POINTER
+///     || LL_ERROR_INVALID_LINK if #link is already on a list or #pos isn't on one
+ll_Error ll_intrusive_link_after(ll_IntrusiveList *self, ll_Link *pos, ll_Link *link) {
+    if (self == NULL) return LL_ERROR_NULL_LINKED_LIST_POINTER;
+    if (pos == NULL || link == NULL) return LL_ERROR_NULL_NODE_POINTER;
+    if (!ll_link_is_linked(pos) || ll_link_is_linked(link)) return LL_ERROR_INVALID_LINK;
+    link_between(self, pos, pos->next, link);
+    return LL_OK;
+}
+
+
+/// unlinks #link, which must be on #self. its struct is left untouched.
+/// @returns LL_OK
+///     || LL_ERROR_NULL_LINKED_LIST_POINTER
+///     || LL_ERROR_NULL_NODE_POINTER
+///     || LL_ERROR_INVALID_LINK if #link isn't on a list
+ll_Error ll_intrusive_unlink(ll_IntrusiveList *self, ll_Link *link) {
+    if (self == NULL) return LL_ERROR_NULL_LINKED_LIST_POINTER;
+    if (link == NULL) return LL_ERROR_NULL_NODE_POINTER;
+    if (!ll_link_is_linked(link) || link == &self->root) return LL_ERROR_INVALID_LINK;
+    unlink_link(self, link);
+    return LL_OK;
+}
+
+
+/// returns the head, or NULL if the list is empty.
+ll_Link* ll_intrusive_first(const ll_IntrusiveList *self) {
+    if (self == NULL || self->len == 0) return NULL;
+    return self->root.next;
+}
+
+
+/// returns the tail, or NULL if the list is empty.
+ll_Link* ll_intrusive_last(const ll_IntrusiveList *self) {
+    if (self == NULL || self->len == 0) return NULL;
+    return self->root.prev;
+}
+
+
+/// returns the link after #link on #self, or NULL if #link is the tail.
+ll_Link* ll_intrusive_next(const ll_IntrusiveList *self, const ll_Link *link) {
+    if (self == NULL || link == NULL || link->next == &self->root) return NULL;
+    return link->next;
+}
+
+
+/// returns the link before #link on #self, or NULL if #link is the head.
+ll_Link* ll_intrusive_prev(const ll_IntrusiveList *self, const ll_Link *link) {
+    if (self == NULL || link == NULL || link->prev == &self->root) return NULL;
+    return link->prev;
+}
@@ -0,0 +1,289 @@
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdbool.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "ll_mmap.h"
+#define ERROR_RETURN_COLD
+#include "common_macros.h"
+
+#define LL_MAP_MAGIC 0x50414d4cu // "LMAP"
+#define LL_MAP_VERSION 1u
+#define LL_MAP_INITIAL_SIZE (1 << 16)
+
+// file header, stored at offset 0 of the mapping
+struct ll_MapHeader {
+    u32 magic;
+    u32 version;
+    u32 data_size;
+    u32 node_size;
+    u64 head;
+    u64 tail;
+    u64 free_nodes;     // freed nodes linked through their next offset
+    u64 bump;           // offset of the first never used byte
+    u64 len;
+};
+
+static inline struct ll_MapHeader* header(const ll_MappedLinkedList *self) {
+    return (struct ll_MapHeader*)self->base;
+}
+
+static inline struct ll_MappedLinkedListNode* node_at(const ll_MappedLinkedList *self, u64 offset) {
+    return (struct ll_MappedLinkedListNode*)(self->base + offset);
+}
+
+static ll_Error map_file(ll_MappedLinkedList *self, size_t size) {
+    void *base = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, self->fd, 0);
+    if (base == MAP_FAILED) return LL_ERROR_IO_FAILURE;
+    self->base = base;
+    self->size = size;
+    return LL_OK;
+}
+
+
+/// opens the list stored at #path, or creates an empty one if the file doesn't exist or is empty.
+/// opening an existing list only maps it, no matter its length.
+/// @returns LL_OK
+///     || LL_ERROR_NULL_LINKED_LIST_POINTER
+///     || LL_ERROR_INSUFFICIENT_SIZE if a node of #data_size bytes can't be addressed
+///     || LL_ERROR_IO_FAILURE
+///     || LL_ERROR_INVALID_FORMAT if the file isn't a list of #data_size elements
+ll_Error ll_map_open(ll_MappedLinkedList *self, const char *path, u32 data_size) {
+    if (self == NULL) return LL_ERROR_NULL_LINKED_LIST_POINTER;
+    if (data_size > UINT32_MAX - sizeof(struct ll_MappedLinkedListNode) - 7) return LL_ERROR_INSUFFICIENT_SIZE;
+
+    int fd = open(path, O_RDWR | O_CREAT, 0644);
+    if (fd < 0) return LL_ERROR_IO_FAILURE;
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        close(fd);
+        return LL_ERROR_IO_FAILURE;
+    }
+
+    bool created = st.st_size == 0;
+    size_t size = created ? LL_MAP_INITIAL_SIZE : (size_t)st.st_size;
+    if ((created && ftruncate(fd, size) != 0) || size < sizeof(struct ll_MapHeader)) {
+        close(fd);
+        return created ? LL_ERROR_IO_FAILURE : LL_ERROR_INVALID_FORMAT;
+    }
+
+    self->fd = fd;
+    self->data_size = data_size;
+    ll_Error status = map_file(self, size);
+    if (status != LL_OK) {
+        close(fd);
+        return status;
+    }
+
+    struct ll_MapHeader *h = header(self);
+    if (created) {
+        h->magic = LL_MAP_MAGIC;
+        h->version = LL_MAP_VERSION;
+        h->data_size = data_size;
+        // keep nodes 8-byte aligned so the offsets can be dereferenced in place
+        h->node_size = (sizeof(struct ll_MappedLinkedListNode) + data_size + 7) & ~7u;
+        h->head = 0;
+        h->tail = 0;
+        h->free_nodes = 0;
+        h->bump = sizeof(struct ll_MapHeader);
+        h->len = 0;
+    } else if (h->magic != LL_MAP_MAGIC || h->version != LL_MAP_VERSION || h->data_size != data_size
+            || h->bump > size) {
+        ll_map_close(self);
+        return LL_ERROR_INVALID_FORMAT;
+    }
+
+    return LL_OK;
+}
+
+
+/// unmaps and closes the file. changes are not flushed to disk, see ll_map_sync.
+/// @returns LL_OK || LL_ERROR_NULL_LINKED_LIST_POINTER || LL_ERROR_IO_FAILURE
+ll_Error ll_map_close(ll_MappedLinkedList *self) {
+    if (self == NULL || self->base == NULL) return LL_ERROR_NULL_LINKED_LIST_POINTER;
+
+    ll_Error status = LL_OK;
+    if (munmap(self->base, self->size) != 0) status = LL_ERROR_IO_FAILURE;
+    if (close(self->fd) != 0) status = LL_ERROR_IO_FAILURE;
+    self->base = NULL;
+    self->size = 0;
+    self->fd = -1;
+    return status;
+}
+
+
+/// blocks until every change to the list is written to the file.
+/// @returns LL_OK || LL_ERROR_NULL_LINKED_LIST_POINTER || LL_ERROR_IO_FAILURE
+ll_Error ll_map_sync(const ll_MappedLinkedList *self) {
+    if (self == NULL || self->base == NULL) return LL_ERROR_NULL_LINKED_LIST_POINTER;
+    if (msync(self->base, self->size, MS_SYNC) != 0) return LL_ERROR_IO_FAILURE;
+    return LL_OK;
+}
+
+
+u64 ll_map_len(const ll_MappedLinkedList *self) {
+    if (self == NULL || self->base == NULL) return 0;
+    return header(self)->len;
+}
+
+
+/// takes a node from the free list, or from the unused end of the file. the file is doubled until the node fits
+/// and remapped when it's full, which invalidates node pointers but not offsets. the old mapping is kept if the
+/// new one fails.
+/// @returns LL_OK || LL_ERROR_IO_FAILURE
+static ll_Error alloc_node(ll_MappedLinkedList *self, u64 *out_offset) {
+    struct ll_MapHeader *h = header(self);
+    if (h->free_nodes != 0) {
+        *out_offset = h->free_nodes;
+        h->free_nodes = node_at(self, h->free_nodes)->next;
+        return LL_OK;
+    }
+
+    if (h->bump + h->node_size > self->size) {
+        size_t new_size = self->size;
+        while (h->bump + h->node_size > new_size) {
+            if (new_size > SIZE_MAX / 2) return LL_ERROR_IO_FAILURE;
+            new_size *= 2;
+        }
+        if (ftruncate(self->fd, new_size) != 0) return LL_ERROR_IO_FAILURE;
+        void *old_base = self->base;
+        size_t old_size = self->size;
+        EXPECT_PASS(map_file(self, new_size));
+        if (munmap(old_base, old_size) != 0) ERROR_RETURN(LL_ERROR_IO_FAILURE);
+        h = header(self);
+    }
+
+    *out_offset = h->bump;
+    h->bump += h->node_size;
+    return LL_OK;
+}
+
+static void free_node(ll_MappedLinkedList *self, u64 offset) {
+    struct ll_MapHeader *h = header(self);
+    node_at(self, offset)->next = h->free_nodes;
+    h->free_nodes = offset;
+}
+
+
+/// @returns LL_OK
+///     || LL_ERROR_NULL_LINKED_LIST_POINTER
+///     || LL_ERROR_NULL_ELEMENT_POINTER
+///     || LL_ERROR_IO_FAILURE if the file couldn't grow
+ll_Error ll_map_push(ll_MappedLinkedList *self, const void *elem) {
+    if (self == NULL || self->base == NULL) return LL_ERROR_NULL_LINKED_LIST_POINTER;
+    if (elem == NULL) return LL_ERROR_NULL_ELEMENT_POINTER;
+
+    u64 offset = EXPECT_S(alloc_node, self, u64);
+    struct ll_MapHeader *h = header(self);
+    struct ll_MappedLinkedListNode *node = node_at(self, offset);
+    node->next = 0;
+    node->prev = h->tail;
+    memcpy(node->data, elem, self->data_size);
+
+    if (h->tail == 0) h->head = offset;
+    else node_at(self, h->tail)->next = offset;
+    h->tail = offset;
+    h->len++;
+    return LL_OK;
+}
+
+
+/// @returns LL_OK
+///     || LL_ERROR_NULL_LINKED_LIST_POINTER
+///     || LL_ERROR_NULL_ELEMENT_POINTER
+///     || LL_ERROR_IO_FAILURE if the file couldn't grow
+ll_Error ll_map_push_front(ll_MappedLinkedList *self, const void *elem) {
+    if (self == NULL || self->base == NULL) return LL_ERROR_NULL_LINKED_LIST_POINTER;
+    if (elem == NULL) return LL_ERROR_NULL_ELEMENT_POINTER;
+
+    u64 offset = EXPECT_S(alloc_node, self, u64);
+    struct ll_MapHeader *h = header(self);
+    struct ll_MappedLinkedListNode *node = node_at(self, offset);
+    node->next = h->head;
+    node->prev = 0;
+    memcpy(node->data, elem, self->data_size);
+
+    if (h->head == 0) h->tail = offset;
+    else node_at(self, h->head)->prev = offset;
+    h->head = offset;
+    h->len++;
+    return LL_OK;
+}
+
+
+/// @param out_elem node element is written to it, or ignored if NULL.
+/// @returns LL_OK
+///     || LL_ERROR_NULL_LINKED_LIST_POINTER
+///     || LL_ERROR_EMPTY_LINKED_LIST
+ll_Error ll_map_pop(ll_MappedLinkedList *self, void *out_elem) {
+    if (self == NULL || self->base == NULL) return LL_ERROR_NULL_LINKED_LIST_POINTER;
+    struct ll_MapHeader *h = header(self);
+    if (h->len == 0) return LL_ERROR_EMPTY_LINKED_LIST;
+    if (h->tail == 0) ERROR_RETURN(LL_ERROR_INTERNAL);
+
+    u64 offset = h->tail;
+    struct ll_MappedLinkedListNode *node = node_at(self, offset);
+    if (out_elem != NULL) memcpy(out_elem, node->data, self->data_size);
+
+    h->tail = node->prev;
+    if (h->tail == 0) h->head = 0;
+    else node_at(self, h->tail)->next = 0;
+    h->len--;
+
+    free_node(self, offset);
+    return LL_OK;
+}
+
+
+/// @param out_elem node element is written to it, or ignored if NULL.
+/// @returns LL_OK
+///     || LL_ERROR_NULL_LINKED_LIST_POINTER
+///     || LL_ERROR_EMPTY_LINKED_LIST
+ll_Error ll_map_pop_front(ll_MappedLinkedList *self, void *out_elem) {
+    if (self == NULL || self->base == NULL) return LL_ERROR_NULL_LINKED_LIST_POINTER;
+    struct ll_MapHeader *h = header(self);
+    if (h->len == 0) return LL_ERROR_EMPTY_LINKED_LIST;
+    if (h->head == 0) ERROR_RETURN(LL_ERROR_INTERNAL);
+
+    u64 offset = h->head;
+    struct ll_MappedLinkedListNode *node = node_at(self, offset);
+    if (out_elem != NULL) memcpy(out_elem, node->data, self->data_size);
+
+    h->head = node->next;
+    if (h->head == 0) h->tail = 0;
+    else node_at(self, h->head)->prev = 0;
+    h->len--;
+
+    free_node(self, offset);
+    return LL_OK;
+}
+
+
+/// retrieves the element at #index, walking from whichever end is closer.
+/// @returns LL_OK
+///     || LL_ERROR_NULL_LINKED_LIST_POINTER
+///     || LL_ERROR_NULL_ELEMENT_POINTER
+///     || LL_ERROR_INDEX_OUT_OF_BOUNDS
+ll_Error ll_map_get(const ll_MappedLinkedList *self, void *out_elem, u64 index) {
+    if (self == NULL || self->base == NULL) return LL_ERROR_NULL_LINKED_LIST_POINTER;
+    if (out_elem == NULL) return LL_ERROR_NULL_ELEMENT_POINTER;
+    const struct ll_MapHeader *h = header(self);
+    if (index >= h->len) return LL_ERROR_INDEX_OUT_OF_BOUNDS;
+
+    u64 offset;
+    if (h->len - index < index) {
+        offset = h->tail;
+        for (u64 i = h->len - 1; i > index; i--) offset = node_at(self, offset)->prev;
+    } else {
+        offset = h->head;
+        for (u64 i = 0; i < index; i++) offset = node_at(self, offset)->next;
+    }
+
+    if (offset == 0) ERROR_RETURN(LL_ERROR_INTERNAL);
+    memcpy(out_elem, node_at(self, offset)->data, self->data_size);
+    return LL_OK;
+}
@@ -0,0 +1,201 @@
+#include <stdlib.h>
+#include <string.h>
+#include "ll_node_arena.h"
+
+#define LL_NODE_ARENA_MIN_CAPACITY 64
+
+static inline struct ll_ArenaNode* node_at(const ll_NodeArena *self, u32 node) {
+    return (struct ll_ArenaNode*)(self->nodes + (size_t)node * self->node_size);
+}
+
+
+/// @param data_size size of every element of the arena's lists.
+/// @param initial_capacity nodes to reserve up front, the arena grows by doubling past it.
+/// @returns LL_OK
+///     || LL_ERROR_NULL_ELEMENT_POINTER
+///     || LL_ERROR_INSUFFICIENT_SIZE if a node of #data_size bytes can't be addressed
+///     || LL_ERROR_MALLOC_FAILURE
+ll_Error ll_node_arena_init(ll_NodeArena *self, u32 data_size, u32 initial_capacity) {
+    if (self == NULL) return LL_ERROR_NULL_ELEMENT_POINTER;
+    if (data_size > UINT32_MAX - sizeof(struct ll_ArenaNode) - 8) return LL_ERROR_INSUFFICIENT_SIZE;
+
+    // payloads that are a multiple of 8 bytes stay 8 byte aligned, the others only need the links aligned
+    u32 align = data_size % 8 == 0 ? 8 : 4;
+    self->node_size = (sizeof(struct ll_ArenaNode) + data_size + align - 1) & ~(align - 1);
+    self->data_size = data_size;
+    // one more for the reserved LL_ARENA_NIL slot
+    self->capacity = initial_capacity < LL_NODE_ARENA_MIN_CAPACITY ? LL_NODE_ARENA_MIN_CAPACITY : initial_capacity;
+    if (self->capacity < UINT32_MAX) self->capacity++;
+    self->nodes = malloc((size_t)self->capacity * self->node_size);
+    if (self->nodes == NULL) return LL_ERROR_MALLOC_FAILURE;
+    self->used = 1;
+    self->free_head = LL_ARENA_NIL;
+    return LL_OK;
+}
+
+
+/// frees the arena and with it every node of every list using it, in O(1).
+/// @returns LL_OK
+///     || LL_ERROR_NULL_ELEMENT_POINTER
+ll_Error ll_node_arena_destroy(ll_NodeArena *self) {
+    if (self == NULL) return LL_ERROR_NULL_ELEMENT_POINTER;
+    free(self->nodes);
+    self->nodes = NULL;
+    self->capacity = 0;
+    self->used = 0;
+    self->free_head = LL_ARENA_NIL;
+    return LL_OK;
+}
+
+
+/// drops every node of every list using the arena in O(1), keeping its memory. the lists' headers must be
+/// reinitialized before they are used again.
+/// @returns LL_OK
+///     || LL_ERROR_NULL_ELEMENT_POINTER
+ll_Error ll_node_arena_reset(ll_NodeArena *self) {
+    if (self == NULL) return LL_ERROR_NULL_ELEMENT_POINTER;
+    self->used = 1;
+    self->free_head = LL_ARENA_NIL;
+    return LL_OK;
+}
+
+
+/// returns the payload of #node. it's invalidated when the arena grows, so by any push.
+void* ll_node_arena_data(const ll_NodeArena *self, u32 node) {
+    return node_at(self, node)->data;
+}
+
+
+/// returns the node after #node in its list, or LL_ARENA_NIL.
+u32 ll_node_arena_next(const ll_NodeArena *self, u32 node) {
+    return node_at(self, node)->next;
+}
+
+
+/// returns the node before #node in its list, or LL_ARENA_NIL.
+u32 ll_node_arena_prev(const ll_NodeArena *self, u32 node) {
+    return node_at(self, node)->prev;
+}
+
+
+/// returns the index of a node holding a copy of #elem, or LL_ARENA_NIL on failure.
+static u32 node_new(ll_NodeArena *self, const void *elem) {
+    u32 node = self->free_head;
+    if (node != LL_ARENA_NIL) {
+        self->free_head = node_at(self, node)->next;
+    } else {
+        if (self->used == self->capacity) {
+            if (self->capacity == UINT32_MAX) return LL_ARENA_NIL;
+            u32 capacity = self->capacity > UINT32_MAX / 2 ? UINT32_MAX : self->capacity * 2;
+            u8 *nodes = realloc(self->nodes, (size_t)capacity * self->node_size);
+            if (nodes == NULL) return LL_ARENA_NIL;
+            self->nodes = nodes;
+            self->capacity = capacity;
+        }
+        node = self->used++;
+    }
+    memcpy(node_at(self, node)->data, elem, self->data_size);
+    return node;
+}
+
+static inline void node_delete(ll_NodeArena *self, u32 node) {
+    node_at(self, node)->next = self->free_head;
+    self->free_head = node;
+}
+
+
+/// copies #arena->data_size bytes of #elem to a new tail node.
+/// @returns LL_OK
+///     || LL_ERROR_NULL_LINKED_LIST_POINTER
+///     || LL_ERROR_NULL_ELEMENT_POINTER
+///     || LL_ERROR_MALLOC_FAILURE
+ll_Error ll_arena_list_push(ll_NodeArena *arena, ll_ArenaList *self, const void *elem) {
+    if (arena == NULL || self == NULL) return LL_ERROR_NULL_LINKED_LIST_POINTER;
+    if (elem == NULL) return LL_ERROR_NULL_ELEMENT_POINTER;
+
+    u32 node = node_new(arena, elem);
+    if (node == LL_ARENA_NIL) return LL_ERROR_MALLOC_FAILURE;
+    node_at(arena, node)->next = LL_ARENA_NIL;
+    node_at(arena, node)->prev = self->tail;
+    if (self->tail == LL_ARENA_NIL) self->head = node;
+    else node_at(arena, self->tail)->next = node;
+    self->tail = node;
+    self->len++;
+    return LL_OK;
+}
+
+
+/// copies #arena->data_size bytes of #elem to a new head node.
+/// @returns LL_OK
+///     || LL_ERROR_NULL_LINKED_LIST_POINTER
+///     || LL_ERROR_NULL_ELEMENT_POINTER
+///     || LL_ERROR_MALLOC_FAILURE
+ll_Error ll_arena_list_push_front(ll_NodeArena *arena, ll_ArenaList *self, const void *elem) {
+    if (arena == NULL || self == NULL) return LL_ERROR_NULL_LINKED_LIST_POINTER;
+    if (elem == NULL) return LL_ERROR_NULL_ELEMENT_POINTER;
+
+    u32 node = node_new(arena, elem);
+    if (node == LL_ARENA_NIL) return LL_ERROR_MALLOC_FAILURE;
+    node_at(arena, node)->prev = LL_ARENA_NIL;
+    node_at(arena, node)->next = self->head;
+    if (self->head == LL_ARENA_NIL) self->tail = node;
+    else node_at(arena, self->head)->prev = node;
+    self->head = node;
+    self->len++;
+    return LL_OK;
+}
+
+
+/// removes the tail node.
+/// @param out_elem data of the tail node is copied to it, or discarded if NULL.
+/// @returns LL_OK
+///     || LL_ERROR_NULL_LINKED_LIST_POINTER
+///     || LL_ERROR_EMPTY_LINKED_LIST
+ll_Error ll_arena_list_pop(ll_NodeArena *arena, ll_ArenaList *self, void *out_elem) {
+    if (arena == NULL || self == NULL) return LL_ERROR_NULL_LINKED_LIST_POINTER;
+    if (self->tail == LL_ARENA_NIL) return LL_ERROR_EMPTY_LINKED_LIST;
+
+    u32 node = self->tail;
+    if (out_elem != NULL) memcpy(out_elem, node_at(arena, node)->data, arena->data_size);
+    self->tail = node_at(arena, node)->prev;
+    if (self->tail == LL_ARENA_NIL) self->head = LL_ARENA_NIL;
+    else node_at(arena, self->tail)->next = LL_ARENA_NIL;
+    self->len--;
+    node_delete(arena, node);
+    return LL_OK;
+}
+
+
+/// removes the head node.
+/// @param out_elem data of the head node is copied to it, or discarded if NULL.
+/// @returns LL_OK
+///     || LL_ERROR_NULL_LINKED_LIST_POINTER
+///     || LL_ERROR_EMPTY_LINKED_LIST
+ll_Error ll_arena_list_pop_front(ll_NodeArena *arena, ll_ArenaList *self, void *out_elem) {
+    if (arena == NULL || self == NULL) return LL_ERROR_NULL_LINKED_LIST_POINTER;
+    if (self->head == LL_ARENA_NIL) return LL_ERROR_EMPTY_LINKED_LIST;
+
+    u32 node = self->head;
+    if (out_elem != NULL) memcpy(out_elem, node_at(arena, node)->data, arena->data_size);
+    self->head = node_at(arena, node)->next;
+    if (self->head == LL_ARENA_NIL) self->tail = LL_ARENA_NIL;
+    else node_at(arena, self->head)->prev = LL_ARENA_NIL;
+    self->len--;
+    node_delete(arena, node);
+    return LL_OK;
+}
+
+
+/// gives every node of the list back to the arena in O(1) and empties it.
+/// @returns LL_OK
+///     || LL_ERROR_NULL_LINKED_LIST_POINTER
+ll_Error ll_arena_list_clear(ll_NodeArena *arena, ll_ArenaList *self) {
+    if (arena == NULL || self == NULL) return LL_ERROR_NULL_LINKED_LIST_POINTER;
+    if (self->head != LL_ARENA_NIL) {
+        // the list is already chained through next, so it's spliced onto the free list whole
+        node_at(arena, self->tail)->next = arena->free_head;
+        arena->free_head = self->head;
+    }
+    *self = (ll_ArenaList)LL_ARENA_LIST_INIT;
+    return LL_OK;
+}
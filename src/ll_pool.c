@@ -0,0 +1,224 @@
+#include <stdint.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include "ll_pool.h"
+
+// slabs start small so that short lists stay cheap and double up to a cap so that big lists amortize
+// the allocator calls.
+#define LL_POOL_MIN_SLAB_NODES 8
+#define LL_POOL_MAX_SLAB_NODES 4096
+
+
+/// @param node_size size of a node in bytes, rounded up so nodes stay pointer aligned and can hold the
+/// free list link.
+/// @param alloc allocator of the slabs, or NULL for ll_default_allocator.
+void ll_pool_init(ll_NodePool *self, size_t node_size, const ll_Allocator *alloc, void *alloc_ctx) {
+    if (node_size < sizeof(void*)) node_size = sizeof(void*);
+    node_size = (node_size + sizeof(void*) - 1) & ~(sizeof(void*) - 1);
+
+    self->slabs = NULL;
+    self->free_nodes = NULL;
+    self->node_size = node_size;
+    self->next_capacity = LL_POOL_MIN_SLAB_NODES;
+    self->alloc = alloc != NULL ? alloc : &ll_default_allocator;
+    self->alloc_ctx = alloc_ctx;
+    self->inline_slab = NULL;
+}
+
+static inline size_t slab_size(const ll_NodePool *self, size_t capacity) {
+    return sizeof(struct ll_PoolSlab) + capacity * self->node_size;
+}
+
+
+/// returns the bytes taken by a slab of #capacity nodes, header included.
+size_t ll_pool_slab_bytes(const ll_NodePool *self, size_t capacity) {
+    return slab_size(self, capacity);
+}
+
+
+/// frees every slab at once. nodes handed out by the pool are invalidated without being visited.
+/// nothing is freed if the allocator can only release memory in bulk, and the inline slab is never freed.
+void ll_pool_destroy(ll_NodePool *self) {
+    if (self->alloc->free != NULL) {
+        struct ll_PoolSlab *slab = self->slabs;
+        while (slab) {
+            struct ll_PoolSlab *next = slab->next;
+            if (slab != self->inline_slab) self->alloc->free(self->alloc_ctx, slab, slab_size(self, slab->capacity));
+            slab = next;
+        }
+    }
+    self->slabs = NULL;
+    self->free_nodes = NULL;
+    self->inline_slab = NULL;
+}
+
+
+/// makes #memory, ll_pool_slab_bytes(#capacity) bytes owned by the caller, an empty slab of the pool. it
+/// becomes the newest slab so that nodes are taken from it first. the pool can hold a single inline slab.
+void ll_pool_add_inline(ll_NodePool *self, void *memory, size_t capacity) {
+    struct ll_PoolSlab *slab = memory;
+    slab->capacity = capacity;
+    slab->used = 0;
+    slab->next = self->slabs;
+    self->slabs = slab;
+    self->inline_slab = slab;
+}
+
+
+/// removes the inline slab from the pool and returns it, or NULL if there's none. the free list is dropped as it
+/// may hold nodes of the inline slab, so the pool must not hand out nodes it recycled before.
+struct ll_PoolSlab* ll_pool_detach_inline(ll_NodePool *self) {
+    struct ll_PoolSlab *slab = self->inline_slab;
+    if (slab == NULL) return NULL;
+    for (struct ll_PoolSlab **link = &self->slabs; *link; link = &(*link)->next) {
+        if (*link == slab) {
+            *link = slab->next;
+            break;
+        }
+    }
+    self->free_nodes = NULL;
+    self->inline_slab = NULL;
+    return slab;
+}
+
+
+static struct ll_PoolSlab* new_slab(const ll_NodePool *self, size_t capacity) {
+    if (capacity > (SIZE_MAX - sizeof(struct ll_PoolSlab)) / self->node_size) return NULL;
+
+    struct ll_PoolSlab *slab = self->alloc->alloc(self->alloc_ctx, slab_size(self, capacity));
+    if (slab == NULL) return NULL;
+    slab->next = NULL;
+    slab->capacity = capacity;
+    slab->used = 0;
+    return slab;
+}
+
+
+/// returns a node of #self->node_size bytes, or NULL on failure.
+/// recycled nodes are preferred, then the remaining space of the newest slab.
+void* ll_pool_alloc(ll_NodePool *self) {
+    if (self->free_nodes != NULL) {
+        void *node = self->free_nodes;
+        self->free_nodes = *(void**)node;
+        return node;
+    }
+
+    if (self->slabs == NULL || self->slabs->used == self->slabs->capacity) {
+        struct ll_PoolSlab *slab = new_slab(self, self->next_capacity);
+        if (slab == NULL) return NULL;
+        slab->next = self->slabs;
+        self->slabs = slab;
+        if (self->next_capacity < LL_POOL_MAX_SLAB_NODES) self->next_capacity *= 2;
+    }
+
+    return self->slabs->nodes + self->slabs->used++ * self->node_size;
+}
+
+
+/// returns #count contiguous nodes spaced #self->node_size bytes apart, or NULL on failure.
+/// this is used to build many nodes with a single allocation. the free list is not consulted since its nodes
+/// are scattered.
+void* ll_pool_alloc_run(ll_NodePool *self, size_t count) {
+    if (count == 0) return NULL;
+
+    struct ll_PoolSlab *slab = self->slabs;
+    if (slab != NULL && slab->capacity - slab->used >= count) {
+        void *run = slab->nodes + slab->used * self->node_size;
+        slab->used += count;
+        return run;
+    }
+
+    // the run gets an exactly sized slab. it's kept behind the newest slab so that the newest slab's remaining
+    // space is still used by ll_pool_alloc.
+    slab = new_slab(self, count);
+    if (slab == NULL) return NULL;
+    slab->used = count;
+    if (self->slabs == NULL) {
+        self->slabs = slab;
+    } else {
+        slab->next = self->slabs->next;
+        self->slabs->next = slab;
+    }
+
+    return slab->nodes;
+}
+
+
+/// returns a node to the pool. it's reused by the next ll_pool_alloc.
+void ll_pool_free(ll_NodePool *self, void *node) {
+    *(void**)node = self->free_nodes;
+    self->free_nodes = node;
+}
+
+
+/// returns whether #node is in the pool's inline slab.
+bool ll_pool_is_inline(const ll_NodePool *self, const void *node) {
+    const struct ll_PoolSlab *slab = self->inline_slab;
+    return slab != NULL && (const u8*)node >= slab->nodes
+           && (const u8*)node < slab->nodes + slab->capacity * self->node_size;
+}
+
+
+/// returns whether ll_pool_adopt can move the slabs of #other to the pool: their nodes have the same size and
+/// come from the same allocator.
+bool ll_pool_can_adopt(const ll_NodePool *self, const ll_NodePool *other) {
+    return self->node_size == other->node_size && self->alloc == other->alloc && self->alloc_ctx == other->alloc_ctx;
+}
+
+
+/// moves every slab and free node of #other to the pool, so its nodes stay valid and are released with the pool.
+/// #other keeps its inline slab, emptied, whose nodes the caller must not use anymore.
+/// the slabs go behind the newest slab of the pool, the free list is walked once to drop the inline nodes.
+void ll_pool_adopt(ll_NodePool *self, ll_NodePool *other) {
+    void *node = other->free_nodes;
+    while (node) {
+        void *next = *(void**)node;
+        if (!ll_pool_is_inline(other, node)) ll_pool_free(self, node);
+        node = next;
+    }
+
+    struct ll_PoolSlab *inline_slab = ll_pool_detach_inline(other);
+    if (other->slabs != NULL) {
+        struct ll_PoolSlab *last = other->slabs;
+        while (last->next) last = last->next;
+        if (self->slabs == NULL) {
+            self->slabs = other->slabs;
+        } else {
+            last->next = self->slabs->next;
+            self->slabs->next = other->slabs;
+        }
+    }
+    other->slabs = NULL;
+    other->free_nodes = NULL;
+    if (inline_slab != NULL) ll_pool_add_inline(other, inline_slab, inline_slab->capacity);
+}
+
+
+/// returns the bytes of every slab, headers included.
+size_t ll_pool_footprint(const ll_NodePool *self) {
+    size_t bytes = 0;
+    for (const struct ll_PoolSlab *slab = self->slabs; slab; slab = slab->next) {
+        bytes += slab_size(self, slab->capacity);
+    }
+    return bytes;
+}
+
+
+/// tells the kernel that the whole pages inside the slabs are unused. this is for allocators that can't free
+/// slabs, their memory is given back to the OS and reads as zeros if it's reused. the pool must not be used
+/// afterwards except to be destroyed.
+/// returns the bytes released.
+size_t ll_pool_discard_pages(ll_NodePool *self) {
+    const uintptr_t page = (uintptr_t)sysconf(_SC_PAGESIZE);
+    size_t released = 0;
+    for (struct ll_PoolSlab *slab = self->slabs; slab; slab = slab->next) {
+        if (slab == self->inline_slab) continue;
+        // the slab header is kept so the list of slabs can still be walked
+        uintptr_t start = ((uintptr_t)slab->nodes + page - 1) & ~(page - 1);
+        uintptr_t end = ((uintptr_t)slab + slab_size(self, slab->capacity)) & ~(page - 1);
+        if (end <= start) continue;
+        if (madvise((void*)start, end - start, MADV_DONTNEED) == 0) released += end - start;
+    }
+    self->free_nodes = NULL;
+    return released;
+}
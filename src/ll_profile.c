@@ -0,0 +1,329 @@
+#ifdef LL_PROFILE
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "lib.h"
+#include "ll_xor.h"
+#include "ll_profile.h"
+
+#ifdef __linux__
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#endif
+
+/* hardware counter profiling of the list variants, built and ran with `make profile`.
+ * each counter is opened on its own rather than as a group so that whichever subset the machine supports is
+ * still reported. counters that can't be opened (no PMU in a VM, perf_event_paranoid, non Linux) show as n/a
+ * and the wall clock time is always reported.
+ */
+
+#define PROFILE_SCAN_LEN (1 << 16)
+#define PROFILE_SCAN_ROUNDS 64
+#define PROFILE_RANDOM_LEN (1 << 12)
+#define PROFILE_RANDOM_OPS (1 << 14)
+#define PROFILE_CHURN_LEN 1024
+#define PROFILE_CHURN_OPS (1 << 20)
+#define PROFILE_MIDDLE_LEN (1 << 12)
+#define PROFILE_MIDDLE_OPS (1 << 13)
+
+typedef struct {
+    const char *name;
+    u32 type;
+    u64 config;
+}CounterSpec;
+
+#ifdef __linux__
+#define CACHE_READ_MISS(cache) \
+    ((cache) | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16))
+
+static const CounterSpec counter_specs[] = {
+    {"cycles", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+    {"instr", PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+    {"L1d-miss", PERF_TYPE_HW_CACHE, CACHE_READ_MISS(PERF_COUNT_HW_CACHE_L1D)},
+    {"LLC-miss", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+    {"dTLB-miss", PERF_TYPE_HW_CACHE, CACHE_READ_MISS(PERF_COUNT_HW_CACHE_DTLB)},
+    {"br-miss", PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+};
+#else
+static const CounterSpec counter_specs[] = {
+    {"cycles", 0, 0}, {"instr", 0, 0}, {"L1d-miss", 0, 0},
+    {"LLC-miss", 0, 0}, {"dTLB-miss", 0, 0}, {"br-miss", 0, 0},
+};
+#endif
+
+#define COUNTERS (sizeof(counter_specs) / sizeof(counter_specs[0]))
+
+typedef struct {
+    int fds[COUNTERS];
+    // scaled by the time each counter was actually running, in case the PMU multiplexed them
+    u64 values[COUNTERS];
+    bool valid[COUNTERS];
+    u64 start_ns;
+    u64 elapsed_ns;
+}Counters;
+
+static inline u64 now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (u64)ts.tv_sec * 1000000000u + ts.tv_nsec;
+}
+
+/// opens every counter for the calling thread, disabled. prints why a counter is unavailable the first time.
+static void counters_open(Counters *self) {
+    static bool reported[COUNTERS];
+    for (u32 i = 0; i < COUNTERS; i++) {
+        self->fds[i] = -1;
+#ifdef __linux__
+        struct perf_event_attr attr;
+        memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = counter_specs[i].type;
+        attr.config = counter_specs[i].config;
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+        self->fds[i] = (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+        if (self->fds[i] < 0 && !reported[i]) {
+            fprintf(stderr, "profile: %s unavailable: %s\n", counter_specs[i].name, strerror(errno));
+        }
+#else
+        if (!reported[i]) fprintf(stderr, "profile: %s unavailable: not Linux\n", counter_specs[i].name);
+#endif
+        reported[i] = true;
+    }
+}
+
+static void counters_close(Counters *self) {
+#ifdef __linux__
+    for (u32 i = 0; i < COUNTERS; i++) {
+        if (self->fds[i] >= 0) close(self->fds[i]);
+    }
+#endif
+}
+
+/// starts counting. the workloads call it once their list is set up so that only the measured loop counts.
+static void counters_start(Counters *self) {
+#ifdef __linux__
+    for (u32 i = 0; i < COUNTERS; i++) {
+        if (self->fds[i] < 0) continue;
+        ioctl(self->fds[i], PERF_EVENT_IOC_RESET, 0);
+        ioctl(self->fds[i], PERF_EVENT_IOC_ENABLE, 0);
+    }
+#endif
+    self->start_ns = now_ns();
+}
+
+static void counters_stop(Counters *self) {
+    self->elapsed_ns = now_ns() - self->start_ns;
+    for (u32 i = 0; i < COUNTERS; i++) {
+        self->valid[i] = false;
+#ifdef __linux__
+        if (self->fds[i] < 0) continue;
+        ioctl(self->fds[i], PERF_EVENT_IOC_DISABLE, 0);
+        u64 data[3]; // value, time enabled, time running
+        if (read(self->fds[i], data, sizeof(data)) != sizeof(data) || data[2] == 0) continue;
+        self->values[i] = data[2] < data[1] ? (u64)((double)data[0] * data[1] / data[2]) : data[0];
+        self->valid[i] = true;
+#endif
+    }
+}
+
+
+// keeps the compiler from discarding the values read by the workloads
+static volatile u64 profile_sink;
+
+/// fills #list with #len ascending values.
+static bool fill(const ll_ProfileVariant *variant, void *list, u64 len) {
+    for (u64 i = 0; i < len; i++) {
+        if (variant->push(list, i) != LL_OK) return false;
+    }
+    return true;
+}
+
+/// each workload builds its list, counts its measured loop with #counters and returns the number of operations,
+/// or 0 if the variant lacks the callbacks it needs.
+typedef u64 (*Workload)(const ll_ProfileVariant *variant, void *list, Counters *counters);
+
+static u64 workload_scan(const ll_ProfileVariant *variant, void *list, Counters *counters) {
+    if (variant->scan == NULL || !fill(variant, list, PROFILE_SCAN_LEN)) return 0;
+    counters_start(counters);
+    for (u32 r = 0; r < PROFILE_SCAN_ROUNDS; r++) profile_sink += variant->scan(list);
+    counters_stop(counters);
+    return (u64)PROFILE_SCAN_LEN * PROFILE_SCAN_ROUNDS;
+}
+
+static u64 workload_random_index(const ll_ProfileVariant *variant, void *list, Counters *counters) {
+    if (variant->get == NULL || !fill(variant, list, PROFILE_RANDOM_LEN)) return 0;
+    static u32 indices[PROFILE_RANDOM_OPS];
+    u32 x = 0x9E3779B9;
+    for (u32 i = 0; i < PROFILE_RANDOM_OPS; i++) {
+        x ^= x << 13; x ^= x >> 17; x ^= x << 5;
+        indices[i] = x % PROFILE_RANDOM_LEN;
+    }
+
+    counters_start(counters);
+    for (u32 i = 0; i < PROFILE_RANDOM_OPS; i++) {
+        u64 out = 0;
+        variant->get(list, indices[i], &out);
+        profile_sink += out;
+    }
+    counters_stop(counters);
+    return PROFILE_RANDOM_OPS;
+}
+
+static u64 workload_queue_churn(const ll_ProfileVariant *variant, void *list, Counters *counters) {
+    if (!fill(variant, list, PROFILE_CHURN_LEN)) return 0;
+    counters_start(counters);
+    for (u64 i = 0; i < PROFILE_CHURN_OPS; i++) {
+        u64 out = 0;
+        variant->push(list, i);
+        variant->pop_front(list, &out);
+        profile_sink += out;
+    }
+    counters_stop(counters);
+    return PROFILE_CHURN_OPS;
+}
+
+static u64 workload_middle(const ll_ProfileVariant *variant, void *list, Counters *counters) {
+    if (variant->insert == NULL || variant->remove == NULL || !fill(variant, list, PROFILE_MIDDLE_LEN)) return 0;
+    counters_start(counters);
+    for (u64 i = 0; i < PROFILE_MIDDLE_OPS; i++) {
+        u64 out = 0;
+        variant->insert(list, PROFILE_MIDDLE_LEN / 2, i);
+        variant->remove(list, PROFILE_MIDDLE_LEN / 2, &out);
+        profile_sink += out;
+    }
+    counters_stop(counters);
+    return PROFILE_MIDDLE_OPS;
+}
+
+
+static const ll_ProfileVariant *variants[LL_PROFILE_MAX_VARIANTS];
+static u32 variant_count;
+
+/// adds #variant to the report. it must stay valid until the report is printed.
+/// @returns LL_OK
+///     || LL_ERROR_NULL_ELEMENT_POINTER if #variant or one of its required callbacks is NULL
+///     || LL_ERROR_INSUFFICIENT_SIZE if LL_PROFILE_MAX_VARIANTS are already registered
+ll_Error ll_profile_register(const ll_ProfileVariant *variant) {
+    if (variant == NULL || variant->name == NULL || variant->create == NULL || variant->destroy == NULL
+        || variant->push == NULL || variant->pop_front == NULL) {
+        return LL_ERROR_NULL_ELEMENT_POINTER;
+    }
+    if (variant_count == LL_PROFILE_MAX_VARIANTS) return LL_ERROR_INSUFFICIENT_SIZE;
+    variants[variant_count++] = variant;
+    return LL_OK;
+}
+
+
+// ll_LinkedList ---------------------------------------------------------------------------------------------------
+
+static void* list_create(void) { return ll_new(sizeof(u64)); }
+static void list_destroy(void *list) { ll_free((ll_LinkedList**)&list); }
+static ll_Error list_push(void *list, u64 value) { return ll_push(list, &value); }
+static ll_Error list_pop_front(void *list, u64 *out) { return ll_pop_front(list, out); }
+static ll_Error list_get(const void *list, size_t index, u64 *out) { return ll_get64(list, out, index); }
+static ll_Error list_insert(void *list, size_t index, u64 value) { return ll_insert64(list, index, &value); }
+static ll_Error list_remove(void *list, size_t index, u64 *out) { return ll_remove64(list, out, index); }
+
+static u64 list_scan(const void *list) {
+    u64 sum = 0;
+    for (const struct ll_LinkedListNode *node = ((const ll_LinkedList*)list)->head; node; node = node->next) {
+        u64 value;
+        memcpy(&value, node->data, sizeof(value));
+        sum += value;
+    }
+    return sum;
+}
+
+static const ll_ProfileVariant linked_list_variant = {
+    .name = "ll_LinkedList",
+    .create = list_create,
+    .destroy = list_destroy,
+    .push = list_push,
+    .pop_front = list_pop_front,
+    .scan = list_scan,
+    .get = list_get,
+    .insert = list_insert,
+    .remove = list_remove,
+};
+
+// ll_XorLinkedList ------------------------------------------------------------------------------------------------
+
+static void* xor_create(void) { return ll_xor_new(sizeof(u64)); }
+static void xor_destroy(void *list) { ll_xor_free((ll_XorLinkedList**)&list); }
+static ll_Error xor_push(void *list, u64 value) { return ll_xor_push(list, &value); }
+static ll_Error xor_pop_front(void *list, u64 *out) { return ll_xor_pop_front(list, out); }
+
+static u64 xor_scan(const void *list) {
+    u64 sum = 0;
+    ll_XorCursor cursor;
+    ll_xor_cursor_front(list, &cursor);
+    while (cursor.node != NULL) {
+        u64 value;
+        memcpy(&value, cursor.node->data, sizeof(value));
+        sum += value;
+        ll_xor_cursor_next(&cursor);
+    }
+    return sum;
+}
+
+static const ll_ProfileVariant xor_list_variant = {
+    .name = "ll_XorLinkedList",
+    .create = xor_create,
+    .destroy = xor_destroy,
+    .push = xor_push,
+    .pop_front = xor_pop_front,
+    .scan = xor_scan,
+};
+
+
+int main(void) {
+    ll_profile_register(&linked_list_variant);
+    ll_profile_register(&xor_list_variant);
+
+    const struct {
+        const char *name;
+        Workload run;
+    } workloads[] = {
+        {"scan", workload_scan},
+        {"random index", workload_random_index},
+        {"queue churn", workload_queue_churn},
+        {"middle ins/rm", workload_middle},
+    };
+
+    Counters counters;
+    counters_open(&counters);
+
+    printf("%-18s %-14s %9s", "variant", "workload", "ns/op");
+    for (u32 c = 0; c < COUNTERS; c++) printf(" %10s", counter_specs[c].name);
+    printf("\n");
+
+    for (u32 v = 0; v < variant_count; v++) {
+        for (u32 w = 0; w < sizeof(workloads) / sizeof(workloads[0]); w++) {
+            void *list = variants[v]->create();
+            if (list == NULL) {
+                fprintf(stderr, "profile: %s: create failed\n", variants[v]->name);
+                break;
+            }
+            u64 ops = workloads[w].run(variants[v], list, &counters);
+            variants[v]->destroy(list);
+            if (ops == 0) continue;
+
+            printf("%-18s %-14s %9.2f", variants[v]->name, workloads[w].name, (double)counters.elapsed_ns / ops);
+            for (u32 c = 0; c < COUNTERS; c++) {
+                if (counters.valid[c]) printf(" %10.3f", (double)counters.values[c] / ops);
+                else printf(" %10s", "n/a");
+            }
+            printf("\n");
+        }
+    }
+
+    counters_close(&counters);
+    return 0;
+}
+#endif // LL_PROFILE
@@ -0,0 +1,131 @@
+#include <string.h>
+#include <time.h>
+#include "ll_trace.h"
+
+#ifdef LL_TRACE
+
+#if defined(LL_TRACE_RDTSC) && (defined(__x86_64__) || defined(__i386__))
+#include <x86intrin.h>
+#endif
+
+static ll_Histogram histograms[LL_OP_COUNT];
+static ll_TraceHooks trace_hooks;
+static void *trace_ctx;
+
+static inline u64 now(void) {
+#if defined(LL_TRACE_RDTSC) && (defined(__x86_64__) || defined(__i386__))
+    return __rdtsc();
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (u64)ts.tv_sec * 1000000000u + ts.tv_nsec;
+#endif
+}
+
+static inline u32 bucket_of(u64 ticks) {
+    return ticks == 0 ? 0 : 63 - __builtin_clzll(ticks);
+}
+
+/// starts timing #op. returns the start tick to pass to ll_trace_end.
+u64 ll_trace_begin(ll_Op op, i64 index, size_t len) {
+    if (trace_hooks.enter != NULL) trace_hooks.enter(op, index, len, trace_ctx);
+    return now();
+}
+
+/// records the latency of #op since #start. counters are updated atomically so that lists used from
+/// different threads can be traced together.
+void ll_trace_end(ll_Op op, i64 index, size_t len, ll_Error status, u64 start) {
+    u64 ticks = now() - start;
+    ll_Histogram *h = &histograms[op];
+    __atomic_fetch_add(&h->count, 1, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&h->total_ticks, ticks, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&h->buckets[bucket_of(ticks)], 1, __ATOMIC_RELAXED);
+    u64 max = __atomic_load_n(&h->max_ticks, __ATOMIC_RELAXED);
+    while (ticks > max && !__atomic_compare_exchange_n(&h->max_ticks, &max, ticks, true, __ATOMIC_RELAXED,
+                                                       __ATOMIC_RELAXED));
+
+    if (trace_hooks.exit != NULL) trace_hooks.exit(op, index, len, status, ticks, trace_ctx);
+}
+
+#endif // LL_TRACE
+
+
+/// registers the callbacks invoked around every traced operation. either callback may be NULL, and a NULL
+/// #hooks removes them. hooks are not synchronized, so set them before the lists are shared between threads.
+/// @returns LL_OK || LL_ERROR_UNSUPPORTED if compiled without LL_TRACE
+ll_Error ll_trace_set_hooks(const ll_TraceHooks *hooks, void *ctx) {
+#ifdef LL_TRACE
+    if (hooks == NULL) memset(&trace_hooks, 0, sizeof(trace_hooks));
+    else trace_hooks = *hooks;
+    trace_ctx = ctx;
+    return LL_OK;
+#else
+    return LL_ERROR_UNSUPPORTED;
+#endif
+}
+
+
+/// copies the latency histogram of #op.
+/// @returns LL_OK
+///     || LL_ERROR_NULL_ELEMENT_POINTER
+///     || LL_ERROR_INDEX_OUT_OF_BOUNDS if #op is not an ll_Op
+///     || LL_ERROR_UNSUPPORTED if compiled without LL_TRACE
+ll_Error ll_trace_histogram(ll_Op op, ll_Histogram *out_histogram) {
+    if (out_histogram == NULL) return LL_ERROR_NULL_ELEMENT_POINTER;
+    if ((u32)op >= LL_OP_COUNT) return LL_ERROR_INDEX_OUT_OF_BOUNDS;
+#ifdef LL_TRACE
+    ll_Histogram *h = &histograms[op];
+    out_histogram->count = __atomic_load_n(&h->count, __ATOMIC_RELAXED);
+    out_histogram->total_ticks = __atomic_load_n(&h->total_ticks, __ATOMIC_RELAXED);
+    out_histogram->max_ticks = __atomic_load_n(&h->max_ticks, __ATOMIC_RELAXED);
+    for (u32 i = 0; i < LL_TRACE_BUCKETS; i++) {
+        out_histogram->buckets[i] = __atomic_load_n(&h->buckets[i], __ATOMIC_RELAXED);
+    }
+    return LL_OK;
+#else
+    memset(out_histogram, 0, sizeof(*out_histogram));
+    return LL_ERROR_UNSUPPORTED;
+#endif
+}
+
+
+/// estimates a latency percentile of #op, such as 99.9 for p999, as the upper bound of the bucket containing it.
+/// @returns LL_OK
+///     || LL_ERROR_NULL_ELEMENT_POINTER
+///     || LL_ERROR_INDEX_OUT_OF_BOUNDS if #op is not an ll_Op or #percentile is not within [0, 100]
+///     || LL_ERROR_EMPTY_LINKED_LIST if #op wasn't recorded yet
+///     || LL_ERROR_UNSUPPORTED if compiled without LL_TRACE
+ll_Error ll_trace_percentile(ll_Op op, double percentile, u64 *out_ticks) {
+    if (out_ticks == NULL) return LL_ERROR_NULL_ELEMENT_POINTER;
+    if (percentile < 0 || percentile > 100) return LL_ERROR_INDEX_OUT_OF_BOUNDS;
+
+    ll_Histogram h;
+    ll_Error status = ll_trace_histogram(op, &h);
+    if (status != LL_OK) return status;
+    if (h.count == 0) return LL_ERROR_EMPTY_LINKED_LIST;
+
+    u64 rank = (u64)(percentile / 100 * h.count);
+    if (rank >= h.count) rank = h.count - 1;
+    u64 seen = 0;
+    u32 i = 0;
+    for (; i < LL_TRACE_BUCKETS - 1; i++) {
+        seen += h.buckets[i];
+        if (seen > rank) break;
+    }
+
+    u64 upper = i == LL_TRACE_BUCKETS - 1 ? UINT64_MAX : (2ull << i) - 1;
+    *out_ticks = upper < h.max_ticks ? upper : h.max_ticks;
+    return LL_OK;
+}
+
+
+/// clears every histogram.
+/// @returns LL_OK || LL_ERROR_UNSUPPORTED if compiled without LL_TRACE
+ll_Error ll_trace_reset(void) {
+#ifdef LL_TRACE
+    memset(histograms, 0, sizeof(histograms));
+    return LL_OK;
+#else
+    return LL_ERROR_UNSUPPORTED;
+#endif
+}
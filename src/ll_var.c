@@ -0,0 +1,196 @@
+#include <stdlib.h>
+#include <string.h>
+#include "ll_var.h"
+
+
+static inline u32 size_class_of(u32 len) {
+    u32 size_class = 0;
+    while (size_class < LL_VAR_LARGE_CLASS && (8u << size_class) < len) size_class++;
+    return size_class;
+}
+
+
+/// returns NULL on failure
+ll_VarLinkedList* ll_var_new(void) {
+    ll_VarLinkedList *out = (ll_VarLinkedList*)malloc(sizeof(ll_VarLinkedList));
+    if (out == NULL) return NULL;
+    out->head = NULL;
+    out->tail = NULL;
+    out->len = 0;
+    out->large_nodes = 0;
+    for (u32 i = 0; i < LL_VAR_SIZE_CLASSES; i++) {
+        ll_pool_init(&out->classes[i], sizeof(struct ll_VarLinkedListNode) + (8u << i), NULL, NULL);
+    }
+    return out;
+}
+
+
+/// deallocates the linkedlist and all of the nodes in it, and sets the pointer to NULL.
+/// only nodes too large for a size class are visited.
+/// @returns LL_OK
+///     || LL_ERROR_NULL_LINKED_LIST_POINTER (can happen with double free)
+ll_Error ll_var_free(ll_VarLinkedList **self) {
+    if (self == NULL || *self == NULL) return LL_ERROR_NULL_LINKED_LIST_POINTER;
+
+    if ((*self)->large_nodes > 0) {
+        struct ll_VarLinkedListNode *node = (*self)->head;
+        while (node) {
+            struct ll_VarLinkedListNode *next = node->next;
+            if (node->size_class == LL_VAR_LARGE_CLASS) free(node);
+            node = next;
+        }
+    }
+    for (u32 i = 0; i < LL_VAR_SIZE_CLASSES; i++) ll_pool_destroy(&(*self)->classes[i]);
+
+    free(*self);
+    *self = NULL;
+    return LL_OK;
+}
+
+
+static struct ll_VarLinkedListNode* node_new(ll_VarLinkedList *self, const void *ptr, u32 len) {
+    u32 size_class = size_class_of(len);
+    struct ll_VarLinkedListNode *node;
+    if (size_class == LL_VAR_LARGE_CLASS) {
+        node = malloc(sizeof(struct ll_VarLinkedListNode) + len);
+        if (node != NULL) self->large_nodes++;
+    } else {
+        node = ll_pool_alloc(&self->classes[size_class]);
+    }
+    if (node == NULL) return NULL;
+
+    node->len = len;
+    node->size_class = size_class;
+    if (len > 0) memcpy(node->data, ptr, len);
+    return node;
+}
+
+static void node_delete(ll_VarLinkedList *self, struct ll_VarLinkedListNode *node) {
+    if (node->size_class == LL_VAR_LARGE_CLASS) {
+        free(node);
+        self->large_nodes--;
+    } else {
+        ll_pool_free(&self->classes[node->size_class], node);
+    }
+}
+
+
+/// copies #len bytes from #ptr into a new tail node.
+/// @returns LL_OK
+///     || LL_ERROR_NULL_LINKED_LIST_POINTER
+///     || LL_ERROR_NULL_ELEMENT_POINTER
+///     || LL_ERROR_MALLOC_FAILURE
+ll_Error ll_var_push_bytes(ll_VarLinkedList *self, const void *ptr, u32 len) {
+    if (self == NULL) return LL_ERROR_NULL_LINKED_LIST_POINTER;
+    if (ptr == NULL && len > 0) return LL_ERROR_NULL_ELEMENT_POINTER;
+
+    struct ll_VarLinkedListNode *node = node_new(self, ptr, len);
+    if (node == NULL) return LL_ERROR_MALLOC_FAILURE;
+    node->next = NULL;
+    node->prev = self->tail;
+    if (self->tail == NULL) self->head = node;
+    else self->tail->next = node;
+    self->tail = node;
+    self->len++;
+    return LL_OK;
+}
+
+
+/// copies #len bytes from #ptr into a new head node.
+/// @returns LL_OK
+///     || LL_ERROR_NULL_LINKED_LIST_POINTER
+///     || LL_ERROR_NULL_ELEMENT_POINTER
+///     || LL_ERROR_MALLOC_FAILURE
+ll_Error ll_var_push_front_bytes(ll_VarLinkedList *self, const void *ptr, u32 len) {
+    if (self == NULL) return LL_ERROR_NULL_LINKED_LIST_POINTER;
+    if (ptr == NULL && len > 0) return LL_ERROR_NULL_ELEMENT_POINTER;
+
+    struct ll_VarLinkedListNode *node = node_new(self, ptr, len);
+    if (node == NULL) return LL_ERROR_MALLOC_FAILURE;
+    node->prev = NULL;
+    node->next = self->head;
+    if (self->head == NULL) self->tail = node;
+    else self->head->prev = node;
+    self->head = node;
+    self->len++;
+    return LL_OK;
+}
+
+
+/// points #out_ptr at the payload of the tail node without copying it. it's valid until the node is popped.
+/// @returns LL_OK
+///     || LL_ERROR_NULL_LINKED_LIST_POINTER
+///     || LL_ERROR_NULL_ELEMENT_POINTER
+///     || LL_ERROR_EMPTY_LINKED_LIST
+ll_Error ll_var_peek_bytes(const ll_VarLinkedList *self, const void **out_ptr, u32 *out_len) {
+    if (self == NULL) return LL_ERROR_NULL_LINKED_LIST_POINTER;
+    if (out_ptr == NULL || out_len == NULL) return LL_ERROR_NULL_ELEMENT_POINTER;
+    if (self->tail == NULL) return LL_ERROR_EMPTY_LINKED_LIST;
+
+    *out_ptr = self->tail->data;
+    *out_len = self->tail->len;
+    return LL_OK;
+}
+
+
+/// points #out_ptr at the payload of the head node without copying it. it's valid until the node is popped.
+/// @returns LL_OK
+///     || LL_ERROR_NULL_LINKED_LIST_POINTER
+///     || LL_ERROR_NULL_ELEMENT_POINTER
+///     || LL_ERROR_EMPTY_LINKED_LIST
+ll_Error ll_var_peek_front_bytes(const ll_VarLinkedList *self, const void **out_ptr, u32 *out_len) {
+    if (self == NULL) return LL_ERROR_NULL_LINKED_LIST_POINTER;
+    if (out_ptr == NULL || out_len == NULL) return LL_ERROR_NULL_ELEMENT_POINTER;
+    if (self->head == NULL) return LL_ERROR_EMPTY_LINKED_LIST;
+
+    *out_ptr = self->head->data;
+    *out_len = self->head->len;
+    return LL_OK;
+}
+
+
+/// removes #node after copying its payload to #out, unless #out is NULL.
+/// nothing is removed if the payload doesn't fit in #out_capacity bytes.
+static ll_Error pop_node(ll_VarLinkedList *self, struct ll_VarLinkedListNode *node, void *out, u32 out_capacity,
+                         u32 *out_len) {
+    if (out_len != NULL) *out_len = node->len;
+    if (out != NULL) {
+        if (node->len > out_capacity) return LL_ERROR_INSUFFICIENT_SIZE;
+        memcpy(out, node->data, node->len);
+    }
+
+    if (node->prev == NULL) self->head = node->next;
+    else node->prev->next = node->next;
+    if (node->next == NULL) self->tail = node->prev;
+    else node->next->prev = node->prev;
+    self->len--;
+
+    node_delete(self, node);
+    return LL_OK;
+}
+
+
+/// @param out payload of the tail node is written to it, or discarded if NULL.
+/// @param out_len payload length, also written on LL_ERROR_INSUFFICIENT_SIZE. ignored if NULL.
+/// @returns LL_OK
+///     || LL_ERROR_NULL_LINKED_LIST_POINTER
+///     || LL_ERROR_EMPTY_LINKED_LIST
+///     || LL_ERROR_INSUFFICIENT_SIZE if the payload is longer than #out_capacity. the node is kept.
+ll_Error ll_var_pop_bytes(ll_VarLinkedList *self, void *out, u32 out_capacity, u32 *out_len) {
+    if (self == NULL) return LL_ERROR_NULL_LINKED_LIST_POINTER;
+    if (self->tail == NULL) return LL_ERROR_EMPTY_LINKED_LIST;
+    return pop_node(self, self->tail, out, out_capacity, out_len);
+}
+
+
+/// @param out payload of the head node is written to it, or discarded if NULL.
+/// @param out_len payload length, also written on LL_ERROR_INSUFFICIENT_SIZE. ignored if NULL.
+/// @returns LL_OK
+///     || LL_ERROR_NULL_LINKED_LIST_POINTER
+///     || LL_ERROR_EMPTY_LINKED_LIST
+///     || LL_ERROR_INSUFFICIENT_SIZE if the payload is longer than #out_capacity. the node is kept.
+ll_Error ll_var_pop_front_bytes(ll_VarLinkedList *self, void *out, u32 out_capacity, u32 *out_len) {
+    if (self == NULL) return LL_ERROR_NULL_LINKED_LIST_POINTER;
+    if (self->head == NULL) return LL_ERROR_EMPTY_LINKED_LIST;
+    return pop_node(self, self->head, out, out_capacity, out_len);
+}
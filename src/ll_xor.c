@@ -0,0 +1,184 @@
+#include <stdlib.h>
+#include <string.h>
+#include "ll_xor.h"
+
+/* the link of a node is prev ^ next, with NULL ends contributing 0. both ends of the list look the same, so
+ * pushing and popping at the head is pushing and popping at the tail with #head and #tail swapped.
+ */
+
+static inline struct ll_XorLinkedListNode* xor_step(const struct ll_XorLinkedListNode *from,
+                                                    const struct ll_XorLinkedListNode *node) {
+    return (struct ll_XorLinkedListNode*)(node->link ^ (uintptr_t)from);
+}
+
+
+/// returns NULL on failure
+ll_XorLinkedList* ll_xor_new(u32 data_size) {
+    ll_XorLinkedList *out = (ll_XorLinkedList*)malloc(sizeof(ll_XorLinkedList));
+    if (out == NULL) return NULL;
+    out->head = NULL;
+    out->tail = NULL;
+    out->data_size = data_size;
+    out->len = 0;
+    ll_pool_init(&out->pool, sizeof(struct ll_XorLinkedListNode) + data_size, NULL, NULL);
+    return out;
+}
+
+
+/// deallocates the linkedlist and all of the nodes in it, and sets the pointer to NULL.
+/// @returns LL_OK
+///     || LL_ERROR_NULL_LINKED_LIST_POINTER (can happen with double free)
+ll_Error ll_xor_free(ll_XorLinkedList **self) {
+    if (self == NULL || *self == NULL) return LL_ERROR_NULL_LINKED_LIST_POINTER;
+    ll_pool_destroy(&(*self)->pool);
+    free(*self);
+    *self = NULL;
+    return LL_OK;
+}
+
+
+/// links a new node holding a copy of #elem after #end, which is either the head or the tail.
+static ll_Error push_end(ll_XorLinkedList *self, const void *elem, struct ll_XorLinkedListNode **end,
+                         struct ll_XorLinkedListNode **other_end) {
+    if (self == NULL) return LL_ERROR_NULL_LINKED_LIST_POINTER;
+    if (elem == NULL) return LL_ERROR_NULL_ELEMENT_POINTER;
+
+    struct ll_XorLinkedListNode *node = ll_pool_alloc(&self->pool);
+    if (node == NULL) return LL_ERROR_MALLOC_FAILURE;
+    memcpy(node->data, elem, self->data_size);
+
+    // the old end gains #node as its outer neighbour, which was NULL
+    node->link = (uintptr_t)*end;
+    if (*end == NULL) *other_end = node;
+    else (*end)->link ^= (uintptr_t)node;
+    *end = node;
+    self->len++;
+    return LL_OK;
+}
+
+/// unlinks #end, which is either the head or the tail, after copying its data to #out_elem unless it's NULL.
+static ll_Error pop_end(ll_XorLinkedList *self, void *out_elem, struct ll_XorLinkedListNode **end,
+                        struct ll_XorLinkedListNode **other_end) {
+    if (self == NULL) return LL_ERROR_NULL_LINKED_LIST_POINTER;
+    if (*end == NULL) return LL_ERROR_EMPTY_LINKED_LIST;
+
+    struct ll_XorLinkedListNode *node = *end;
+    if (out_elem != NULL) memcpy(out_elem, node->data, self->data_size);
+
+    // the outer neighbour of an end is NULL, so its link is the address of the inner one
+    struct ll_XorLinkedListNode *inner = xor_step(NULL, node);
+    if (inner == NULL) *other_end = NULL;
+    else inner->link ^= (uintptr_t)node;
+    *end = inner;
+    self->len--;
+
+    ll_pool_free(&self->pool, node);
+    return LL_OK;
+}
+
+
+/// copies #self->data_size bytes of #elem to a new tail node.
+/// @returns LL_OK
+///     || LL_ERROR_NULL_LINKED_LIST_POINTER
+///     || LL_ERROR_NULL_ELEMENT_POINTER
+///     || LL_ERROR_MALLOC_FAILURE
+ll_Error ll_xor_push(ll_XorLinkedList *self, const void *elem) {
+    if (self == NULL) return LL_ERROR_NULL_LINKED_LIST_POINTER;
+    return push_end(self, elem, &self->tail, &self->head);
+}
+
+
+/// copies #self->data_size bytes of #elem to a new head node.
+/// @returns LL_OK
+///     || LL_ERROR_NULL_LINKED_LIST_POINTER
+///     || LL_ERROR_NULL_ELEMENT_POINTER
+///     || LL_ERROR_MALLOC_FAILURE
+ll_Error ll_xor_push_front(ll_XorLinkedList *self, const void *elem) {
+    if (self == NULL) return LL_ERROR_NULL_LINKED_LIST_POINTER;
+    return push_end(self, elem, &self->head, &self->tail);
+}
+
+
+/// removes the tail node.
+/// @param out_elem data of the tail node is copied to it, or discarded if NULL.
+/// @returns LL_OK
+///     || LL_ERROR_NULL_LINKED_LIST_POINTER
+///     || LL_ERROR_EMPTY_LINKED_LIST
+ll_Error ll_xor_pop(ll_XorLinkedList *self, void *out_elem) {
+    if (self == NULL) return LL_ERROR_NULL_LINKED_LIST_POINTER;
+    return pop_end(self, out_elem, &self->tail, &self->head);
+}
+
+
+/// removes the head node.
+/// @param out_elem data of the head node is copied to it, or discarded if NULL.
+/// @returns LL_OK
+///     || LL_ERROR_NULL_LINKED_LIST_POINTER
+///     || LL_ERROR_EMPTY_LINKED_LIST
+ll_Error ll_xor_pop_front(ll_XorLinkedList *self, void *out_elem) {
+    if (self == NULL) return LL_ERROR_NULL_LINKED_LIST_POINTER;
+    return pop_end(self, out_elem, &self->head, &self->tail);
+}
+
+
+/// points #out_cursor at the head, walking towards the tail. #out_cursor->node is NULL if the list is empty.
+/// @returns LL_OK
+///     || LL_ERROR_NULL_LINKED_LIST_POINTER
+///     || LL_ERROR_NULL_ELEMENT_POINTER
+ll_Error ll_xor_cursor_front(const ll_XorLinkedList *self, ll_XorCursor *out_cursor) {
+    if (self == NULL) return LL_ERROR_NULL_LINKED_LIST_POINTER;
+    if (out_cursor == NULL) return LL_ERROR_NULL_ELEMENT_POINTER;
+    *out_cursor = (ll_XorCursor){.list = self, .prev = NULL, .node = self->head};
+    return LL_OK;
+}
+
+
+/// points #out_cursor at the tail, walking towards the head. #out_cursor->node is NULL if the list is empty.
+/// @returns LL_OK
+///     || LL_ERROR_NULL_LINKED_LIST_POINTER
+///     || LL_ERROR_NULL_ELEMENT_POINTER
+ll_Error ll_xor_cursor_back(const ll_XorLinkedList *self, ll_XorCursor *out_cursor) {
+    if (self == NULL) return LL_ERROR_NULL_LINKED_LIST_POINTER;
+    if (out_cursor == NULL) return LL_ERROR_NULL_ELEMENT_POINTER;
+    *out_cursor = (ll_XorCursor){.list = self, .prev = NULL, .node = self->tail};
+    return LL_OK;
+}
+
+
+/// moves the cursor one node further in its direction. #self->node becomes NULL after the last node.
+/// @returns LL_OK
+///     || LL_ERROR_NULL_ELEMENT_POINTER
+///     || LL_ERROR_INDEX_OUT_OF_BOUNDS if the cursor is already past the end
+ll_Error ll_xor_cursor_next(ll_XorCursor *self) {
+    if (self == NULL) return LL_ERROR_NULL_ELEMENT_POINTER;
+    if (self->node == NULL) return LL_ERROR_INDEX_OUT_OF_BOUNDS;
+
+    struct ll_XorLinkedListNode *next = xor_step(self->prev, self->node);
+    self->prev = self->node;
+    self->node = next;
+    return LL_OK;
+}
+
+
+/// turns the cursor around so that it walks back the way it came, staying on the same node.
+/// @returns LL_OK
+///     || LL_ERROR_NULL_ELEMENT_POINTER
+///     || LL_ERROR_INDEX_OUT_OF_BOUNDS if the cursor is past the end
+ll_Error ll_xor_cursor_reverse(ll_XorCursor *self) {
+    if (self == NULL) return LL_ERROR_NULL_ELEMENT_POINTER;
+    if (self->node == NULL) return LL_ERROR_INDEX_OUT_OF_BOUNDS;
+    self->prev = xor_step(self->prev, self->node);
+    return LL_OK;
+}
+
+
+/// copies the data of the node under the cursor to #out_elem.
+/// @returns LL_OK
+///     || LL_ERROR_NULL_ELEMENT_POINTER
+///     || LL_ERROR_INDEX_OUT_OF_BOUNDS if the cursor is past the end
+ll_Error ll_xor_cursor_get(const ll_XorCursor *self, void *out_elem) {
+    if (self == NULL || out_elem == NULL) return LL_ERROR_NULL_ELEMENT_POINTER;
+    if (self->node == NULL) return LL_ERROR_INDEX_OUT_OF_BOUNDS;
+    memcpy(out_elem, self->node->data, self->list->data_size);
+    return LL_OK;
+}